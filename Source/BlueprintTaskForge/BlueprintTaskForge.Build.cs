@@ -36,6 +36,7 @@ public class BlueprintTaskForge : ModuleRules
                 "Core",
                 "CoreUObject",
                 "Engine",
+                "GameplayTags",
             });
 
         PrivateDependencyModuleNames.AddRange(
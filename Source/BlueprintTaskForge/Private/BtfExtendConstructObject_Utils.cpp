@@ -11,6 +11,7 @@
 #include "BtfExtendConstructObject_Utils.h"
 
 #include "BftMacros.h"
+#include "Subsystem/BtfSubsystem.h"
 
 #include "UObject/Object.h"
 #include "Engine/Engine.h"
@@ -19,6 +20,46 @@
 
 // --------------------------------------------------------------------------------------------------------------------
 
+namespace
+{
+    // Large enough for any literal a spawn param pin can hold
+    constexpr auto SpawnParamScratchSize = 1024;
+
+    // Evaluates the next value of the stack without writing it anywhere, so that the values after it still line up
+    void SkipSpawnParamValue(FFrame& Stack)
+    {
+        // Variables report their own address and are not copied when evaluated without a destination
+        switch (static_cast<EExprToken>(*Stack.Code))
+        {
+            case EX_LocalVariable:
+            case EX_LocalOutVariable:
+            case EX_InstanceVariable:
+            case EX_DefaultVariable:
+            case EX_ClassSparseDataVariable:
+            {
+                Stack.StepCompiledIn<FProperty>(nullptr);
+                return;
+            }
+            default:
+                break;
+        }
+
+        // Literals and function results are written to the destination, the scratch value is destroyed through
+        // the property the expression reports, if any
+        alignas(16) uint8 Scratch[SpawnParamScratchSize];
+        FMemory::Memzero(Scratch);
+        Stack.StepCompiledIn<FProperty>(Scratch);
+
+        if (const auto* ValueProperty = Stack.MostRecentProperty;
+            ValueProperty != nullptr && ValueProperty->GetSize() <= SpawnParamScratchSize)
+        {
+            ValueProperty->DestroyValue(Scratch);
+        }
+    }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
 UObject* UBtf_ExtendConstructObject_Utils::ExtendConstructObject(UObject* Outer, const TSubclassOf<UObject> Class)
 {
     if (IsValid(Outer) && IsValid(Class) && NOT Class->HasAnyClassFlags(CLASS_Abstract))
@@ -30,6 +71,83 @@ UObject* UBtf_ExtendConstructObject_Utils::ExtendConstructObject(UObject* Outer,
     return nullptr;
 }
 
+void UBtf_ExtendConstructObject_Utils::BindDelegateByName(UObject* Object, const FName DelegateName, UObject* Listener, const FName FunctionName)
+{
+    if (NOT IsValid(Object) || NOT IsValid(Listener))
+    { return; }
+
+    const auto* DelegateProperty = FindFProperty<FMulticastDelegateProperty>(Object->GetClass(), DelegateName);
+    if (DelegateProperty == nullptr)
+    { return; }
+
+#if !UE_BUILD_SHIPPING
+    const auto* Function = Listener->FindFunction(FunctionName);
+    if (NOT ensureMsgf(IsValid(Function) && Function->IsSignatureCompatibleWith(DelegateProperty->SignatureFunction),
+            TEXT("%s can not be bound to %s.%s"), *GetNameSafe(Function), *GetNameSafe(Object->GetClass()), *DelegateName.ToString()))
+    { return; }
+#endif
+
+    auto Delegate = FScriptDelegate{};
+    Delegate.BindUFunction(Listener, FunctionName);
+    DelegateProperty->AddDelegate(MoveTemp(Delegate), Object);
+}
+
+DEFINE_FUNCTION(UBtf_ExtendConstructObject_Utils::execApplySpawnParams)
+{
+    P_GET_OBJECT(UObject, Object);
+    P_GET_TARRAY_REF(FName, PropertyNames);
+
+    QUICK_SCOPE_CYCLE_COUNTER(ApplySpawnParams)
+
+    auto* EngineSubsystem = IsValid(Object) && IsValid(GEngine) ? GEngine->GetEngineSubsystem<UBtf_EngineSubsystem>() : nullptr;
+
+    // Copied out of the subsystem, evaluating the values below may run script that spawns other tasks
+    auto Properties = TArray<const FProperty*, TInlineAllocator<16>>{};
+    if (IsValid(EngineSubsystem))
+    {
+        Properties = EngineSubsystem->FindSpawnParamProperties(Object->GetClass(), PropertyNames);
+    }
+    else if (IsValid(Object))
+    {
+        for (const auto& PropertyName : PropertyNames)
+        {
+            Properties.Add(FindFProperty<FProperty>(Object->GetClass(), PropertyName));
+        }
+    }
+
+    for (auto Index = 0; Index < PropertyNames.Num(); ++Index)
+    {
+        const auto* Property = Properties.IsValidIndex(Index) ? Properties[Index] : nullptr;
+
+        Stack.MostRecentPropertyAddress = nullptr;
+        Stack.MostRecentProperty = nullptr;
+
+        if (Property == nullptr)
+        {
+            UE_LOG(LogScript, Error, TEXT("ApplySpawnParams: %s has no property %s anymore, its value is dropped. Recompile %s."),
+                *GetNameSafe(IsValid(Object) ? Object->GetClass() : nullptr), *PropertyNames[Index].ToString(),
+                *GetNameSafe(Stack.Node != nullptr ? Stack.Node->GetOuter() : nullptr));
+
+            SkipSpawnParamValue(Stack);
+            continue;
+        }
+
+        // Bitfield bools can not be written to directly, everything else is evaluated straight into the property
+        if (const auto* BoolProperty = CastField<FBoolProperty>(Property))
+        {
+            auto Value = false;
+            Stack.StepCompiledIn<FBoolProperty>(&Value);
+            BoolProperty->SetPropertyValue_InContainer(Object, Value);
+        }
+        else
+        {
+            Stack.StepCompiledIn<FProperty>(Property->ContainerPtrToValuePtr<void>(Object));
+        }
+    }
+
+    P_FINISH;
+}
+
 bool UBtf_ExtendConstructObject_Utils::GetNumericSuffix(const FString& InStr, int32& Suffix)
 {
     const TCHAR* Str = *InStr + InStr.Len() - 1;
@@ -16,6 +16,10 @@
 #include "BtfExtendConstructObject_Utils.h"
 #include "Subsystem/BtfSubsystem.h"
 #include "Settings/BtfRuntimeSettings.h"
+#include "Engine/AssetManager.h"
+#include "Engine/LatentActionManager.h"
+#include "Engine/StreamableManager.h"
+#include "LatentActions.h"
 
 #if WITH_EDITOR
 #include "ObjectEditorUtils.h"
@@ -24,60 +28,347 @@
 
 // --------------------------------------------------------------------------------------------------------------------
 
+namespace
+{
+    class FBtf_LoadTaskClassAction : public FPendingLatentAction
+    {
+    public:
+        FBtf_LoadTaskClassAction(const FLatentActionInfo& InLatentInfo, TSharedPtr<FStreamableHandle> InHandle)
+            : LatentInfo(InLatentInfo)
+            , Handle(MoveTemp(InHandle))
+        {
+        }
+
+        virtual void UpdateOperation(FLatentResponse& Response) override
+        {
+            const auto IsDone = NOT Handle.IsValid() || Handle->HasLoadCompleted() || Handle->WasCanceled();
+            Response.FinishAndTriggerIf(IsDone, LatentInfo.ExecutionFunction, LatentInfo.Linkage, LatentInfo.CallbackTarget);
+        }
+
+        virtual void NotifyObjectDestroyed() override
+        {
+            if (Handle.IsValid())
+            { Handle->CancelHandle(); }
+        }
+
+        virtual void NotifyActionAborted() override
+        {
+            if (Handle.IsValid())
+            { Handle->CancelHandle(); }
+        }
+
+    private:
+        FLatentActionInfo LatentInfo;
+        TSharedPtr<FStreamableHandle> Handle;
+    };
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
 UBtf_TaskForge::UBtf_TaskForge(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 }
 
-UBtf_TaskForge* UBtf_TaskForge::BlueprintTaskForge(UObject* Outer, const TSubclassOf<UBtf_TaskForge> Class, FString NodeGuidStr)
+UBtf_TaskForge* UBtf_TaskForge::BlueprintTaskForge(
+    UObject* Outer,
+    const TSubclassOf<UBtf_TaskForge> Class,
+    FGuid NodeGuid,
+    UBtf_TaskForge* Template,
+    const EBtf_TaskReentrancyPolicy ReentrancyPolicy)
 {
     if (NOT IsValid(Outer) || NOT IsValid(Class) || Class->HasAnyClassFlags(CLASS_Abstract))
     { return nullptr; }
 
-    auto* TaskTemplate = GetTaskByNodeGUID(Outer, NodeGuidStr);
+    // The template is baked into the owning class when the node is compiled, a class mismatch means it is stale
+    auto* TaskTemplate = IsValid(Template) && Template->IsA(Class) ? Template : nullptr;
+
+    const auto World = Outer->GetWorld();
+    auto* WorldSubsystem = IsValid(World) ? World->GetSubsystem<UBtf_WorldSubsystem>() : nullptr;
+
+    const auto TracksNodeTask = ReentrancyPolicy != EBtf_TaskReentrancyPolicy::Parallel && NodeGuid.IsValid() && IsValid(WorldSubsystem);
+    if (TracksNodeTask)
+    {
+        if (auto* ActiveTask = WorldSubsystem->Get_ActiveNodeTask(Outer, NodeGuid))
+        {
+            switch (ReentrancyPolicy)
+            {
+                case EBtf_TaskReentrancyPolicy::RestartExisting:
+                    ActiveTask->Deactivate();
+                    break;
+                case EBtf_TaskReentrancyPolicy::IgnoreWhileRunning:
+                    return nullptr;
+                case EBtf_TaskReentrancyPolicy::Queue:
+                case EBtf_TaskReentrancyPolicy::Parallel:
+                default:
+                    break;
+            }
+        }
+    }
 
-    const auto TaskObjName = MakeUniqueObjectName(Outer, Class, Class->GetFName(), EUniqueObjectNameOptions::GloballyUnique);
-    const auto Task = NewObject<UBtf_TaskForge>(Outer, Class, TaskObjName, RF_NoFlags, TaskTemplate);
+    const auto Task = CreateTask(Outer, Class, TaskTemplate, WorldSubsystem);
 
     if (NOT IsValid(Task))
     { return Task; }
 
+    if (TracksNodeTask && NOT Task->IsRunningOnClassDefaults())
+    {
+        Task->ReentrancyNodeGuid = NodeGuid;
+        Task->ReentrancyPolicy = ReentrancyPolicy;
+    }
+
+#if WITH_EDITOR
+    // The class defaults are shared by every node of a non instanced class, they do not stand for this node
     if (const auto& BlueprintTaskEngineSystem = GEngine->GetEngineSubsystem<UBtf_EngineSubsystem>();
-        IsValid(BlueprintTaskEngineSystem))
+        IsValid(BlueprintTaskEngineSystem) && NOT Task->IsRunningOnClassDefaults())
     {
-        BlueprintTaskEngineSystem->Add(FGuid(NodeGuidStr), Task);
+        BlueprintTaskEngineSystem->Add(NodeGuid, Task);
     }
+#endif
 
     return Task;
 }
 
-UBtf_TaskForge* UBtf_TaskForge::GetTaskByNodeGUID(UObject* Outer, FString NodeGUID)
+TArray<UBtf_TaskForge*> UBtf_TaskForge::SpawnTaskBatch(
+    const TArray<UObject*>& Outers,
+    const TSubclassOf<UBtf_TaskForge> Class,
+    const int32 CountPerOuter,
+    UBtf_TaskForge* SharedParams,
+    const bool ActivateTasks)
 {
-    for (UClass* TemplateOwnerClass = (Outer != nullptr) ? Outer->GetClass() : Outer->GetClass()
-        ; TemplateOwnerClass
-        ; TemplateOwnerClass = TemplateOwnerClass->GetSuperClass())
+    QUICK_SCOPE_CYCLE_COUNTER(TaskNode_SpawnTaskBatch)
+
+    auto Tasks = TArray<UBtf_TaskForge*>{};
+
+    if (NOT IsValid(Class) || Class->HasAnyClassFlags(CLASS_Abstract) || CountPerOuter <= 0 || Outers.IsEmpty())
+    { return Tasks; }
+
+    // Every outer would get the same class defaults, which are neither tracked nor activated more than once
+    if (auto* ClassDefaults = Class->GetDefaultObject<UBtf_TaskForge>();
+        ClassDefaults->IsRunningOnClassDefaults())
+    {
+        Tasks.Add(ClassDefaults);
+        if (ActivateTasks)
+        { ClassDefaults->Activate(); }
+        return Tasks;
+    }
+
+    auto* TaskTemplate = IsValid(SharedParams) && SharedParams->IsA(Class) ? SharedParams : nullptr;
+    if (IsValid(TaskTemplate))
     {
-        if (auto* BPGC = Cast<UBlueprintGeneratedClass>(TemplateOwnerClass))
+        // Params baked by the node only change in the editor, which invalidates their delta, and the params the node
+        // makes at runtime have a delta covering whatever it sets. Any other params belong to the caller and may have
+        // changed since the last batch, their delta is rebuilt every time
+        if (TaskTemplate->HasAnyFlags(RF_ArchetypeObject) || TaskTemplate->TemplateDeltaCoversChangingProperties)
+        { std::ignore = TaskTemplate->CanApplyTemplateDelta(); }
+        else
+        { TaskTemplate->BuildTemplateDelta(); }
+    }
+
+    // Creating the task of such a class again would only deactivate and reset the one already created for the outer
+    const auto IsInstancedPerOuter =
+        Class->GetDefaultObject<UBtf_TaskForge>()->InstancingPolicy == EBtf_TaskInstancingPolicy::InstancedPerOuter;
+    const auto TasksPerOuter = IsInstancedPerOuter ? 1 : CountPerOuter;
+    auto SpawnedOuters = TSet<const UObject*>{};
+
+    Tasks.Reserve(Outers.Num() * TasksPerOuter);
+
+    const UWorld* CachedWorld = nullptr;
+    UBtf_WorldSubsystem* WorldSubsystem = nullptr;
+    for (auto* Outer : Outers)
+    {
+        if (NOT IsValid(Outer))
+        { continue; }
+
+        if (IsInstancedPerOuter)
+        {
+            if (auto AlreadySpawned = false;
+                SpawnedOuters.Add(Outer, &AlreadySpawned), AlreadySpawned)
+            { continue; }
+        }
+
+        if (const auto World = Outer->GetWorld();
+            World != CachedWorld)
+        {
+            CachedWorld = World;
+            WorldSubsystem = IsValid(World) ? World->GetSubsystem<UBtf_WorldSubsystem>() : nullptr;
+        }
+
+        for (auto Index = 0; Index < TasksPerOuter; ++Index)
         {
-#if !UE_BUILD_TEST
-            // ClassGeneratedBy may not be available in Test builds due to optimization
-            if (auto* Blueprint = Cast<UBlueprint>(BPGC->ClassGeneratedBy))
+            if (auto* Task = CreateTask(Outer, Class, TaskTemplate, WorldSubsystem);
+                IsValid(Task))
             {
-                // GetExtensions() might also be stripped in Test builds
-                if (Blueprint->HasAnyFlags(RF_ClassDefaultObject) == false)
-                {
-                    for (TObjectPtr<UBlueprintExtension> Extension : Blueprint->GetExtensions())
-                    {
-                        if (Extension && Extension->IsA<UBtf_TaskForge>() && Extension->GetFName().ToString().Contains(NodeGUID))
-                        {
-                            return Cast<UBtf_TaskForge>(Extension);
-                        }
-                    }
-                }
+                Tasks.Add(Task);
             }
-#endif
         }
     }
 
+    if (NOT ActivateTasks)
+    { return Tasks; }
+
+    // Tasks of the same world are contiguous since they are created outer by outer,
+    // each run is tracked with a single call before being activated
+    for (auto RangeStart = 0; RangeStart < Tasks.Num();)
+    {
+        const auto* RangeWorld = Tasks[RangeStart]->GetWorld();
+        auto RangeEnd = RangeStart + 1;
+        while (RangeEnd < Tasks.Num() && Tasks[RangeEnd]->GetWorld() == RangeWorld)
+        { ++RangeEnd; }
+
+        if (IsValid(RangeWorld))
+        {
+            RangeWorld->GetSubsystem<UBtf_WorldSubsystem>()->TrackTasks(MakeArrayView(Tasks).Slice(RangeStart, RangeEnd - RangeStart));
+        }
+
+        for (auto Index = RangeStart; Index < RangeEnd; ++Index)
+        {
+            Tasks[Index]->Activate_Internal();
+        }
+
+        RangeStart = RangeEnd;
+    }
+
+    return Tasks;
+}
+
+UBtf_TaskForge* UBtf_TaskForge::MakeTaskBatchParams(
+    UObject* Owner,
+    const FName ParamsName,
+    const TSubclassOf<UBtf_TaskForge> Class,
+    UBtf_TaskForge* Template,
+    const TArray<FName>& SpawnParamNames)
+{
+    QUICK_SCOPE_CYCLE_COUNTER(TaskNode_MakeTaskBatchParams)
+
+    if (NOT IsValid(Class))
+    { return nullptr; }
+
+    auto* TaskTemplate = IsValid(Template) && Template->IsA(Class) ? Template : nullptr;
+    if (NOT IsValid(Owner) || ParamsName.IsNone())
+    { return NewObject<UBtf_TaskForge>(GetTransientPackage(), Class, NAME_None, RF_Transient, TaskTemplate); }
+
+    // Every value the node sets is written again before each batch, the rest still holds the template's
+    if (auto* FoundParams = FindObjectFast<UBtf_TaskForge>(Owner, ParamsName);
+        IsValid(FoundParams) && FoundParams->GetClass() == Class.Get())
+    { return FoundParams; }
+    else if (FoundParams != nullptr)
+    {
+        // Left behind by a previous version of the class, recompiling it also recompiles the node's template
+        FoundParams->Rename(nullptr, GetTransientPackage(), REN_DontCreateRedirectors | REN_DoNotDirty | REN_NonTransactional);
+    }
+
+    auto* Params = NewObject<UBtf_TaskForge>(Owner, Class, ParamsName, RF_Transient, TaskTemplate);
+    Params->BuildTemplateDelta(SpawnParamNames);
+    return Params;
+}
+
+void UBtf_TaskForge::LoadTaskClass(UObject* WorldContextObject, const TSoftClassPtr<UBtf_TaskForge> Class, const FLatentActionInfo LatentInfo)
+{
+    QUICK_SCOPE_CYCLE_COUNTER(TaskNode_LoadTaskClass)
+
+    const auto* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+    if (NOT IsValid(World))
+    { return; }
+
+    // Every execution gets its own action, a node executed again while its class is loading must not be dropped
+    auto Handle = Class.IsValid() || Class.IsNull()
+        ? TSharedPtr<FStreamableHandle>{}
+        : UAssetManager::GetStreamableManager().RequestAsyncLoad(Class.ToSoftObjectPath());
+
+    World->GetLatentActionManager().AddNewAction(
+        LatentInfo.CallbackTarget,
+        LatentInfo.UUID,
+        new FBtf_LoadTaskClassAction(LatentInfo, MoveTemp(Handle)));
+}
+
+bool UBtf_TaskForge::IsTaskClassLoaded(const TSoftClassPtr<UBtf_TaskForge> Class)
+{
+    return Class.IsValid();
+}
+
+TSubclassOf<UBtf_TaskForge> UBtf_TaskForge::ResolveTaskClass(const TSoftClassPtr<UBtf_TaskForge> Class)
+{
+    return Class.Get();
+}
+
+UBtf_TaskForge* UBtf_TaskForge::CreateTask(UObject* Outer, UClass* Class, UBtf_TaskForge* Template, UBtf_WorldSubsystem* WorldSubsystem)
+{
+    QUICK_SCOPE_CYCLE_COUNTER(TaskNode_CreateTask)
+
+    auto* ClassDefaults = Class->GetDefaultObject<UBtf_TaskForge>();
+    switch (ClassDefaults->InstancingPolicy)
+    {
+        case EBtf_TaskInstancingPolicy::NonInstanced:
+        {
+            return ClassDefaults;
+        }
+        case EBtf_TaskInstancingPolicy::InstancedPerOuter:
+        {
+            if (NOT IsValid(WorldSubsystem))
+            { break; }
+
+            if (auto* ExistingTask = WorldSubsystem->FindPerOuterTask(Outer, Class))
+            {
+                // Whatever the node bound to the previous execution is cleared by the reset
+                ExistingTask->Deactivate();
+                ExistingTask->ResetForReuse(IsValid(Template) ? Template : ClassDefaults);
+                return ExistingTask;
+            }
+            break;
+        }
+        case EBtf_TaskInstancingPolicy::InstancedPerExecution:
+        default:
+            break;
+    }
+
+    UBtf_TaskForge* Task = nullptr;
+    if (IsValid(WorldSubsystem) && ClassDefaults->CanBePooled())
+    {
+        Task = WorldSubsystem->AcquirePooledTask(Class, Outer, Template);
+    }
+
+    if (Task == nullptr)
+    {
+        const auto TaskObjName = IsValid(WorldSubsystem)
+            ? WorldSubsystem->MakeTaskName(Outer, Class)
+            : MakeUniqueObjectName(Outer, Class, Class->GetFName(), EUniqueObjectNameOptions::GloballyUnique);
+        if (IsValid(Template) && Template->CanApplyTemplateDelta())
+        {
+            // Constructing from the class defaults only copies what differs from the parent class,
+            // the few properties the template actually changes are applied afterwards
+            Task = NewObject<UBtf_TaskForge>(Outer, Class, TaskObjName, RF_NoFlags);
+            Template->ApplyTemplateDelta(Task);
+        }
+        else
+        {
+            Task = NewObject<UBtf_TaskForge>(Outer, Class, TaskObjName, RF_NoFlags, Template);
+        }
+    }
+
+    if (IsValid(WorldSubsystem))
+    {
+        WorldSubsystem->RegisterTaskName(Task);
+
+        if (ClassDefaults->InstancingPolicy == EBtf_TaskInstancingPolicy::InstancedPerOuter)
+        {
+            WorldSubsystem->RegisterPerOuterTask(Task);
+        }
+    }
+
+    return Task;
+}
+
+UBtf_TaskForge* UBtf_TaskForge::GetTaskByNodeGUID(UObject* Outer, const FGuid& NodeGuid)
+{
+    if (NOT IsValid(Outer) || NOT IsValid(GEngine))
+    { return nullptr; }
+
+    if (const auto& BlueprintTaskEngineSubsystem = GEngine->GetEngineSubsystem<UBtf_EngineSubsystem>();
+        IsValid(BlueprintTaskEngineSubsystem))
+    {
+        return BlueprintTaskEngineSubsystem->FindNodeTemplate(Outer->GetClass(), NodeGuid);
+    }
+
     return nullptr;
 }
 
@@ -88,7 +379,11 @@ void UBtf_TaskForge::Activate()
     if (const auto World = GetWorld();
         IsValid(World))
     {
-        World->GetSubsystem<UBtf_WorldSubsystem>()->TrackTask(this);
+        auto* WorldSubsystem = World->GetSubsystem<UBtf_WorldSubsystem>();
+        if (ReentrancyPolicy != EBtf_TaskReentrancyPolicy::Parallel && NOT WorldSubsystem->ClaimNodeTaskSlot(this))
+        { return; }
+
+        WorldSubsystem->TrackTask(this);
     }
 
     Activate_Internal();
@@ -98,28 +393,68 @@ void UBtf_TaskForge::Deactivate()
 {
     QUICK_SCOPE_CYCLE_COUNTER(TaskNode_Deactivate)
 
+    // Deactivated before its turn in the deferred queue, the queue skips it
+    IsPendingDeactivation = false;
+
+    if (IsRunningOnClassDefaults())
+    {
+        Dispatch_Deactivate();
+        return;
+    }
+
+    const auto World = GetWorld();
+    auto* WorldSubsystem = IsValid(World) ? World->GetSubsystem<UBtf_WorldSubsystem>() : nullptr;
+
     if (NOT IsActive)
-    { return; }
+    {
+        // A queued task deactivated before its turn is dropped from the queue
+        if (ReentrancyPolicy == EBtf_TaskReentrancyPolicy::Queue && IsValid(WorldSubsystem))
+        {
+            WorldSubsystem->ReleaseNodeTaskSlot(this);
+        }
+        return;
+    }
 
-    for (const auto& Task : TasksToDeactivateOnDeactivate)
+    // Detached before it is deactivated and the list read again from its head every time, deactivating a child
+    // may end, pool or hand out its siblings
+    while (auto* Task = FirstChildTask.Get())
     {
-        if (Task.IsValid())
+        UntrackTaskForAutomaticDeactivation(Task);
+        if (IsValid(Task))
         {
             Task->Deactivate();
         }
     }
 
-    if (const auto World = GetWorld();
-        IsValid(World))
+    if (IsValid(WorldSubsystem))
     {
-        World->GetSubsystem<UBtf_WorldSubsystem>()->UntrackTask(this);
+        WorldSubsystem->UntrackTask(this);
     }
 
     Deactivate_Internal();
+
+    // Only once the task is fully deactivated, the next queued execution of the node may activate from here
+    if (ReentrancyPolicy != EBtf_TaskReentrancyPolicy::Parallel && IsValid(WorldSubsystem))
+    {
+        WorldSubsystem->ReleaseNodeTaskSlot(this);
+    }
 }
 
 void UBtf_TaskForge::OnDestroy()
 {
+    if (ParentTask != nullptr)
+    {
+        ParentTask->UntrackTaskForAutomaticDeactivation(this);
+    }
+    DetachChildTasks();
+    StopNativeTick();
+
+    if (const auto World = GetWorld();
+        IsValid(World))
+    {
+        World->GetSubsystem<UBtf_WorldSubsystem>()->UnregisterTaskName(this);
+    }
+
     IsBeingDestroyed = true;
     MarkAsGarbage();
 }
@@ -162,21 +497,17 @@ void UBtf_TaskForge::SetupAutomaticCleanup()
     if (NOT IsValid(GetOuter()))
     { return; }
 
-    if (GetOuter()->IsA<AActor>())
+    if (auto* TaskTemplate = Cast<UBtf_TaskForge>(GetOuter()))
     {
-        if (auto* Actor = Cast<AActor>(GetOuter()))
-        {
-            Actor->OnDestroyed.AddDynamic(this, &UBtf_TaskForge::OnActorOuterDestroyed);
-            return;
-        }
+        TaskTemplate->TrackTaskForAutomaticDeactivation(this);
+        return;
     }
 
-    if (GetOuter()->IsA<UBtf_TaskForge>())
+    // A single hook per actor, shared by every task of the actor and of its components
+    if (const auto World = GetWorld();
+        IsValid(World))
     {
-        if (auto* TaskTemplate = Cast<UBtf_TaskForge>(GetOuter()))
-        {
-            TaskTemplate->TrackTaskForAutomaticDeactivation(this);
-        }
+        World->GetSubsystem<UBtf_WorldSubsystem>()->BindOuterLifetime(GetOuter());
     }
 }
 
@@ -186,13 +517,16 @@ void UBtf_TaskForge::Deactivate_Internal()
     if (IsBeingDestroyed)
     { return; }
 
-    if (IsValid(GetOuter()))
+    StopNativeTick();
+
+    if (IsValid(GetOuter()) || IsDeactivatingForDestroyedOuter)
     {
-        Deactivate_BP();
+        Dispatch_Deactivate();
     }
 
     IsActive = false;
 
+#if WITH_EDITOR
     if (IsValid(GEngine))
     {
         if (const auto& BlueprintTaskEngineSubsystem = GEngine->GetEngineSubsystem<UBtf_EngineSubsystem>();
@@ -201,10 +535,95 @@ void UBtf_TaskForge::Deactivate_Internal()
             BlueprintTaskEngineSubsystem->Remove(this);
         }
     }
+#endif
+
+    // The instance is kept by the world subsystem for the next execution on the same outer
+    if (InstancingPolicy == EBtf_TaskInstancingPolicy::InstancedPerOuter && IsValid(GetWorld()))
+    { return; }
+
+    if (CanBePooled())
+    {
+        if (const auto World = GetWorld();
+            IsValid(World) && World->GetSubsystem<UBtf_WorldSubsystem>()->ReturnTaskToPool(this))
+        { return; }
+    }
 
     OnDestroy();
 }
 
+bool UBtf_TaskForge::Query_NodeTitleColor(FLinearColor& OutColor)
+{
+    return Get_ImplementsScriptEvent(EBtf_TaskScriptEvents::NodeTitleColor)
+        ? Get_NodeTitleColor(OutColor)
+        : Get_NodeTitleColor_Implementation(OutColor);
+}
+
+FString UBtf_TaskForge::Query_NodeDescription() const
+{
+    return Get_ImplementsScriptEvent(EBtf_TaskScriptEvents::NodeDescription)
+        ? Get_NodeDescription()
+        : Get_NodeDescription_Implementation();
+}
+
+FString UBtf_TaskForge::Query_StatusString() const
+{
+    return Get_ImplementsScriptEvent(EBtf_TaskScriptEvents::StatusString)
+        ? Get_StatusString()
+        : Get_StatusString_Implementation();
+}
+
+bool UBtf_TaskForge::Query_StatusBackgroundColor(FLinearColor& OutColor) const
+{
+    return Get_ImplementsScriptEvent(EBtf_TaskScriptEvents::StatusBackgroundColor)
+        ? Get_StatusBackgroundColor(OutColor)
+        : Get_StatusBackgroundColor_Implementation(OutColor);
+}
+
+bool UBtf_TaskForge::Get_ImplementsScriptEvent(const EBtf_TaskScriptEvents InEvent) const
+{
+    const auto* ClassDefaults = GetClass()->GetDefaultObject<UBtf_TaskForge>();
+
+    if (NOT ClassDefaults->ScriptEventsBuilt)
+    {
+        QUICK_SCOPE_CYCLE_COUNTER(TaskNode_BuildScriptEvents)
+
+        const auto* Class = GetClass();
+        auto Events = EBtf_TaskScriptEvents::None;
+
+        const auto AddIfImplemented = [&](const FName InFunctionName, const EBtf_TaskScriptEvents InFlag)
+        {
+            if (Class->IsFunctionImplementedInScript(InFunctionName))
+            { Events |= InFlag; }
+        };
+
+        AddIfImplemented(GET_FUNCTION_NAME_CHECKED(UBtf_TaskForge, Activate_BP), EBtf_TaskScriptEvents::Activate);
+        AddIfImplemented(GET_FUNCTION_NAME_CHECKED(UBtf_TaskForge, Deactivate_BP), EBtf_TaskScriptEvents::Deactivate);
+        AddIfImplemented(GET_FUNCTION_NAME_CHECKED(UBtf_TaskForge, Get_NodeTitleColor), EBtf_TaskScriptEvents::NodeTitleColor);
+        AddIfImplemented(GET_FUNCTION_NAME_CHECKED(UBtf_TaskForge, Get_NodeDescription), EBtf_TaskScriptEvents::NodeDescription);
+        AddIfImplemented(GET_FUNCTION_NAME_CHECKED(UBtf_TaskForge, Get_StatusString), EBtf_TaskScriptEvents::StatusString);
+        AddIfImplemented(GET_FUNCTION_NAME_CHECKED(UBtf_TaskForge, Get_StatusBackgroundColor), EBtf_TaskScriptEvents::StatusBackgroundColor);
+
+        ClassDefaults->ScriptEvents = Events;
+        ClassDefaults->ScriptEventsBuilt = true;
+    }
+
+    return EnumHasAnyFlags(ClassDefaults->ScriptEvents, InEvent);
+}
+
+void UBtf_TaskForge::InvalidateScriptEvents()
+{
+    auto DerivedClasses = TArray<UClass*>{};
+    GetDerivedClasses(StaticClass(), DerivedClasses);
+
+    for (const auto* Class : DerivedClasses)
+    {
+        if (const auto* ClassDefaults = Cast<UBtf_TaskForge>(Class->GetDefaultObject(false)))
+        {
+            ClassDefaults->ScriptEventsBuilt = false;
+        }
+    }
+}
+
 bool UBtf_TaskForge::Get_StatusBackgroundColor_Implementation(FLinearColor& OutColor) const
 {
     OutColor = FLinearColor();
@@ -223,14 +642,40 @@ TArray<FString> UBtf_TaskForge::ValidateNodeDuringCompilation_Implementation()
 
 void UBtf_TaskForge::DeactivateAllTasksRelatedToObject(UObject* Object)
 {
-    auto SubObjects = TArray<UObject*>{};
-    GetObjectsWithOuter(Object, SubObjects);
+    QUICK_SCOPE_CYCLE_COUNTER(DeactivateAllTasksRelatedToObject)
 
-    for (auto& CurrentObject : SubObjects)
+    if (NOT IsValid(Object))
+    { return; }
+
+    const auto* World = Object->GetWorld();
+    auto* WorldSubsystem = IsValid(World) ? World->GetSubsystem<UBtf_WorldSubsystem>() : nullptr;
+    if (NOT IsValid(WorldSubsystem))
     {
-        if (auto* TaskTemplate = Cast<UBtf_TaskForge>(CurrentObject))
+        // Not part of a world, nothing is tracked for it
+        auto SubObjects = TArray<UObject*>{};
+        GetObjectsWithOuter(Object, SubObjects);
+
+        for (auto& CurrentObject : SubObjects)
         {
-            TaskTemplate->Deactivate();
+            if (auto* TaskTemplate = Cast<UBtf_TaskForge>(CurrentObject))
+            {
+                TaskTemplate->Deactivate();
+            }
+        }
+        return;
+    }
+
+    // Collected up front, deactivating a task changes the registry and may deactivate other tasks
+    auto TasksToDeactivate = TArray<TWeakObjectPtr<UBtf_TaskForge>>{};
+    WorldSubsystem->CollectTasksRelatedToObject(Object, TasksToDeactivate);
+
+    for (const auto& WeakTask : TasksToDeactivate)
+    {
+        // A task returned to the pool by an earlier deactivation may have been handed out to another outer
+        if (auto* Task = WeakTask.Get();
+            IsValid(Task) && Task->IsIn(Object))
+        {
+            Task->Deactivate();
         }
     }
 }
@@ -261,27 +706,41 @@ bool UBtf_TaskForge::Get_NodeTitleColor_Implementation(FLinearColor& Color)
     return false;
 }
 
-bool UBtf_TaskForge::IsExtension() const
+FBtf_TaskHandle UBtf_TaskForge::Get_TaskHandle() const
 {
-#if !UE_BUILD_TEST
-    for (UObject* TemplateOwnerClass = (GetOuter() != nullptr) ? GetOuter() : nullptr
-        ; TemplateOwnerClass
-        ; TemplateOwnerClass = TemplateOwnerClass->GetOuter())
+    if (const auto World = GetWorld();
+        IsValid(World))
     {
-        if (auto* BPGC = Cast<UBlueprintGeneratedClass>(TemplateOwnerClass))
-        {
-            if (auto* Blueprint = Cast<UBlueprint>(BPGC->ClassGeneratedBy))
-            {
-                return Blueprint->GetExtensions().Contains(this);
-            }
-        }
+        return World->GetSubsystem<UBtf_WorldSubsystem>()->Get_TaskHandle(this);
+    }
 
-        if (auto* Blueprint = Cast<UBlueprint>(TemplateOwnerClass))
-        {
-            return Blueprint->GetExtensions().Contains(this);
-        }
+    return FBtf_TaskHandle{};
+}
+
+UBtf_TaskForge* UBtf_TaskForge::ResolveTaskHandle(UObject* WorldContextObject, const FBtf_TaskHandle Handle)
+{
+    if (NOT Handle.IsSet() || NOT IsValid(GEngine))
+    { return nullptr; }
+
+    if (const auto* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+        IsValid(World))
+    {
+        return World->GetSubsystem<UBtf_WorldSubsystem>()->ResolveTaskHandle(Handle);
+    }
+
+    return nullptr;
+}
+
+bool UBtf_TaskForge::IsExtension() const
+{
+    if (NOT IsValid(GEngine))
+    { return false; }
+
+    if (const auto& BlueprintTaskEngineSubsystem = GEngine->GetEngineSubsystem<UBtf_EngineSubsystem>();
+        IsValid(BlueprintTaskEngineSubsystem))
+    {
+        return BlueprintTaskEngineSubsystem->IsNodeTemplate(this);
     }
-#endif
 
     return false;
 }
@@ -292,27 +751,254 @@ void UBtf_TaskForge::Activate_Internal()
     if (IsBeingDestroyed)
     { return; }
 
+    // Nothing is tracked or cleaned up for non-instanced tasks, they only run their events
+    if (IsRunningOnClassDefaults())
+    {
+        Dispatch_Activate();
+        return;
+    }
+
     if (IsValid(GetOuter()))
     {
         SetupAutomaticCleanup();
         IsActive = true;
+        Dispatch_Activate();
+    }
+}
+
+void UBtf_TaskForge::Dispatch_Activate()
+{
+    if (NativeDispatch == nullptr)
+    {
+        if (Get_ImplementsScriptEvent(EBtf_TaskScriptEvents::Activate))
+        {
+            Activate_BP();
+        }
+        return;
+    }
+
+    NativeDispatch->Activate(*this);
+
+    if (NativeDispatch->Tick != nullptr && IsActive)
+    {
+        if (const auto World = GetWorld();
+            IsValid(World))
+        {
+            World->GetSubsystem<UBtf_WorldSubsystem>()->StartNativeTick(this);
+        }
+    }
+
+    // Only Blueprint subclasses of a native task go through the Blueprint VM, and only if they implement the event
+    if ((IsActive || IsRunningOnClassDefaults()) && Get_ImplementsScriptEvent(EBtf_TaskScriptEvents::Activate))
+    {
         Activate_BP();
     }
 }
 
+void UBtf_TaskForge::Dispatch_Deactivate()
+{
+    if (NativeDispatch == nullptr)
+    {
+        if (Get_ImplementsScriptEvent(EBtf_TaskScriptEvents::Deactivate))
+        {
+            Deactivate_BP();
+        }
+        return;
+    }
+
+    NativeDispatch->Deactivate(*this);
+
+    if (Get_ImplementsScriptEvent(EBtf_TaskScriptEvents::Deactivate))
+    {
+        Deactivate_BP();
+    }
+}
+
+void UBtf_TaskForge::StopNativeTick()
+{
+    if (NativeTickIndex == INDEX_NONE)
+    { return; }
+
+    if (const auto World = GetWorld();
+        IsValid(World))
+    {
+        World->GetSubsystem<UBtf_WorldSubsystem>()->StopNativeTick(this);
+    }
+
+    // The subsystem drops entries whose task no longer points back at them
+    NativeTickIndex = INDEX_NONE;
+}
+
 void UBtf_TaskForge::TrackTaskForAutomaticDeactivation(UBtf_TaskForge* Task)
 {
-    if (IsValid(Task) && NOT TasksToDeactivateOnDeactivate.Contains(Task))
+    if (NOT IsValid(Task) || Task->ParentTask == this)
+    { return; }
+
+    if (Task->ParentTask != nullptr)
     {
-        TasksToDeactivateOnDeactivate.Add(Task);
+        Task->ParentTask->UntrackTaskForAutomaticDeactivation(Task);
     }
+
+    Task->ParentTask = this;
+    Task->PrevSiblingTask = nullptr;
+    Task->NextSiblingTask = FirstChildTask;
+    if (FirstChildTask != nullptr)
+    {
+        FirstChildTask->PrevSiblingTask = Task;
+    }
+    FirstChildTask = Task;
 }
 
 void UBtf_TaskForge::UntrackTaskForAutomaticDeactivation(UBtf_TaskForge* Task)
 {
-    if (IsValid(Task) && TasksToDeactivateOnDeactivate.Contains(Task))
+    if (Task == nullptr || Task->ParentTask != this)
+    { return; }
+
+    if (Task->PrevSiblingTask != nullptr)
+    { Task->PrevSiblingTask->NextSiblingTask = Task->NextSiblingTask; }
+    else
+    { FirstChildTask = Task->NextSiblingTask; }
+
+    if (Task->NextSiblingTask != nullptr)
+    { Task->NextSiblingTask->PrevSiblingTask = Task->PrevSiblingTask; }
+
+    Task->ParentTask = nullptr;
+    Task->NextSiblingTask = nullptr;
+    Task->PrevSiblingTask = nullptr;
+}
+
+void UBtf_TaskForge::DetachChildTasks()
+{
+    for (auto* Task = FirstChildTask.Get(); Task != nullptr;)
     {
-        TasksToDeactivateOnDeactivate.RemoveSingle(Task);
+        auto* NextTask = Task->NextSiblingTask.Get();
+        Task->ParentTask = nullptr;
+        Task->NextSiblingTask = nullptr;
+        Task->PrevSiblingTask = nullptr;
+        Task = NextTask;
+    }
+    FirstChildTask = nullptr;
+}
+
+bool UBtf_TaskForge::CanBePooled() const
+{
+    if (HasAnyFlags(RF_ArchetypeObject) && NOT HasAnyFlags(RF_ClassDefaultObject))
+    { return false; }
+
+    if (InstancingPolicy != EBtf_TaskInstancingPolicy::InstancedPerExecution)
+    { return false; }
+
+    return GetClass()->GetDefaultObject<UBtf_TaskForge>()->AllowPooling && GetDefault<UBtf_RuntimeSettings>()->EnableTaskPooling;
+}
+
+bool UBtf_TaskForge::IsRunningOnClassDefaults() const
+{
+    return InstancingPolicy == EBtf_TaskInstancingPolicy::NonInstanced && HasAnyFlags(RF_ClassDefaultObject);
+}
+
+void UBtf_TaskForge::ResetForReuse(const UBtf_TaskForge* Archetype)
+{
+    QUICK_SCOPE_CYCLE_COUNTER(TaskNode_ResetForReuse)
+
+    // Unlinked before anything is copied, the links of the other tasks still point at this one
+    if (ParentTask != nullptr)
+    {
+        ParentTask->UntrackTaskForAutomaticDeactivation(this);
+    }
+    DetachChildTasks();
+
+    if (IsValid(Archetype) && GetClass()->IsChildOf(Archetype->GetClass()))
+    {
+        for (TFieldIterator<FProperty> PropertyIt(Archetype->GetClass(), EFieldIteratorFlags::IncludeSuper); PropertyIt; ++PropertyIt)
+        {
+            const auto* Property = *PropertyIt;
+
+            // Instanced subobjects belong to the archetype, sharing them would alias state between tasks
+            if (Property->HasAnyPropertyFlags(CPF_InstancedReference | CPF_ContainsInstancedReference))
+            { continue; }
+
+            // The transient state of the base class (such as the links to other tasks) is reset below instead
+            if (Property->HasAnyPropertyFlags(CPF_Transient) && Property->GetOwnerClass() == UBtf_TaskForge::StaticClass())
+            { continue; }
+
+            Property->CopyCompleteValue_InContainer(this, Archetype);
+        }
+    }
+
+    IsBeingDestroyed = false;
+    IsActive = false;
+    IsPendingDeactivation = false;
+    IsDeactivatingForDestroyedOuter = false;
+    StopNativeTick();
+    ReentrancyNodeGuid.Invalidate();
+    ReentrancyPolicy = EBtf_TaskReentrancyPolicy::Parallel;
+    ReentrancyOuter.Reset();
+    NodeQueueTicket = INDEX_NONE;
+}
+
+void UBtf_TaskForge::OnReturnedToPool()
+{
+    if (ParentTask != nullptr)
+    {
+        ParentTask->UntrackTaskForAutomaticDeactivation(this);
+    }
+
+    for (TFieldIterator<FMulticastDelegateProperty> PropertyIt(GetClass(), EFieldIteratorFlags::IncludeSuper); PropertyIt; ++PropertyIt)
+    {
+        PropertyIt->ClearDelegate(this);
+    }
+
+    DetachChildTasks();
+    StopNativeTick();
+}
+
+bool UBtf_TaskForge::CanApplyTemplateDelta() const
+{
+    if (NOT TemplateDeltaBuilt)
+    { BuildTemplateDelta(); }
+
+    return NOT TemplateDeltaHasInstancedReferences;
+}
+
+void UBtf_TaskForge::ApplyTemplateDelta(UBtf_TaskForge* Task) const
+{
+    QUICK_SCOPE_CYCLE_COUNTER(TaskNode_ApplyTemplateDelta)
+
+    if (NOT IsValid(Task) || NOT Task->IsA(GetClass()))
+    { return; }
+
+    if (NOT TemplateDeltaBuilt)
+    { BuildTemplateDelta(); }
+
+    for (const auto* Property : TemplateDelta)
+    {
+        Property->CopyCompleteValue_InContainer(Task, this);
+    }
+}
+
+void UBtf_TaskForge::BuildTemplateDelta(const TConstArrayView<FName> InChangingProperties) const
+{
+    QUICK_SCOPE_CYCLE_COUNTER(TaskNode_BuildTemplateDelta)
+
+    TemplateDelta.Reset();
+    TemplateDeltaHasInstancedReferences = false;
+    TemplateDeltaBuilt = true;
+    TemplateDeltaCoversChangingProperties = NOT InChangingProperties.IsEmpty();
+
+    const auto* ClassDefaults = GetClass()->GetDefaultObject();
+    for (TFieldIterator<FProperty> PropertyIt(GetClass(), EFieldIteratorFlags::IncludeSuper); PropertyIt; ++PropertyIt)
+    {
+        const auto* Property = *PropertyIt;
+        if (Property->HasAnyPropertyFlags(CPF_Transient | CPF_EditorOnly | CPF_Deprecated))
+        { continue; }
+
+        if (Property->Identical_InContainer(this, ClassDefaults) && NOT InChangingProperties.Contains(Property->GetFName()))
+        { continue; }
+
+        if (Property->HasAnyPropertyFlags(CPF_InstancedReference | CPF_ContainsInstancedReference))
+        { TemplateDeltaHasInstancedReferences = true; }
+
+        TemplateDelta.Add(Property);
     }
 }
 
@@ -321,9 +1007,87 @@ UWorld* UBtf_TaskForge::GetWorld() const
     return IsTemplate() ? nullptr : GetOuter() ? GetOuter()->GetWorld() : nullptr;
 }
 
+FString UBtf_TaskForge::GetDetailedInfoInternal() const
+{
+    if (const auto World = GetWorld();
+        IsValid(World))
+    {
+        if (const auto* WorldSubsystem = World->GetSubsystem<UBtf_WorldSubsystem>();
+            IsValid(WorldSubsystem))
+        {
+            return WorldSubsystem->Get_TaskDebugName(this);
+        }
+    }
+
+    return GetName();
+}
+
 void UBtf_TaskForge::OnActorOuterDestroyed(AActor* Actor)
 {
-    Deactivate();
+    if (GetDefault<UBtf_RuntimeSettings>()->DeferDeactivationOfDestroyedOuters && NOT IsPendingDeactivation)
+    {
+        if (const auto World = GetWorld();
+            IsValid(World))
+        {
+            IsPendingDeactivation = true;
+            World->GetSubsystem<UBtf_WorldSubsystem>()->QueueDeferredDeactivation(this);
+            return;
+        }
+    }
+
+    DeactivateForDestroyedOuter();
+}
+
+void UBtf_TaskForge::ReleaseForTeardown()
+{
+    QUICK_SCOPE_CYCLE_COUNTER(TaskNode_ReleaseForTeardown)
+
+    IsPendingDeactivation = false;
+
+    if (IsActive && DeactivateOnTeardown && NOT IsBeingDestroyed && IsValid(GetOuter()))
+    {
+        Dispatch_Deactivate();
+    }
+
+    IsActive = false;
+
+#if WITH_EDITOR
+    if (IsValid(GEngine))
+    {
+        if (const auto& BlueprintTaskEngineSubsystem = GEngine->GetEngineSubsystem<UBtf_EngineSubsystem>();
+            IsValid(BlueprintTaskEngineSubsystem))
+        {
+            BlueprintTaskEngineSubsystem->Remove(this);
+        }
+    }
+#endif
+
+    if (NOT IsBeingDestroyed)
+    {
+        OnDestroy();
+    }
+}
+
+void UBtf_TaskForge::DeactivateForDestroyedOuter()
+{
+    // Still the actor that was destroyed, the task is only moved once it is deactivated
+    auto* Outer = GetOuter();
+
+    {
+        TGuardValue<bool> DestroyedOuterGuard(IsDeactivatingForDestroyedOuter, true);
+        Deactivate();
+    }
+
+    if (InstancingPolicy == EBtf_TaskInstancingPolicy::InstancedPerOuter)
+    {
+        if (const auto World = GetWorld();
+            IsValid(World))
+        {
+            World->GetSubsystem<UBtf_WorldSubsystem>()->ReleasePerOuterTasks(Outer);
+        }
+
+        OnDestroy();
+    }
 }
 
 FString UBtf_TaskForge::Get_StatusString_Implementation() const
@@ -331,12 +1095,12 @@ FString UBtf_TaskForge::Get_StatusString_Implementation() const
     return FString();
 }
 
-#if WITH_EDITOR
 bool UBtf_TaskForge::Get_IsActive() const
 {
     return IsActive;
 }
 
+#if WITH_EDITOR
 void UBtf_TaskForge::CollectSpawnParam(const UClass* InClass, TSet<FName>& Out)
 {
     Out.Reset();
@@ -508,6 +1272,7 @@ void UBtf_TaskForge::RefreshCollected()
 
 void UBtf_TaskForge::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
+    TemplateDeltaBuilt = false;
     RefreshCollected();
     Super::PostEditChangeProperty(PropertyChangedEvent);
 
@@ -0,0 +1,67 @@
+// Copyright (c) 2025 BlueprintTaskForge Maintainers
+//
+// This file is part of the BlueprintTaskForge Plugin for Unreal Engine.
+//
+// Licensed under the BlueprintTaskForge Open Plugin License v1.0 (BTFPL-1.0).
+// You may obtain a copy of the license at:
+// https://github.com/CommitAndChill/BlueprintTaskForge/blob/main/LICENSE.md
+//
+// SPDX-License-Identifier: BTFPL-1.0
+
+#include "BtfTaskPreloadManifest.h"
+#include "BtfTaskForge.h"
+
+#include "Engine/BlueprintGeneratedClass.h"
+
+// --------------------------------------------------------------------------------------------------------------------
+
+const FName UBtf_TaskPreloadManifest::ManifestName = FName(TEXT("BtfPreloadManifest"));
+
+void UBtf_TaskPreloadManifest::CollectTaskClasses(const UClass* InClass, TArray<FSoftObjectPath>& OutClassPaths)
+{
+    // Native classes have no task nodes
+    for (const auto* OwnerClass = InClass; OwnerClass != nullptr; OwnerClass = OwnerClass->GetSuperClass())
+    {
+        if (NOT OwnerClass->IsA<UBlueprintGeneratedClass>())
+        { break; }
+
+        const auto* Manifest = FindObjectFast<UBtf_TaskPreloadManifest>(const_cast<UClass*>(OwnerClass), ManifestName);
+        if (Manifest == nullptr)
+        { continue; }
+
+        for (const auto& TaskClass : Manifest->TaskClasses)
+        {
+            if (NOT TaskClass.IsNull())
+            {
+                OutClassPaths.AddUnique(TaskClass.ToSoftObjectPath());
+            }
+        }
+    }
+}
+
+#if WITH_EDITOR
+void UBtf_TaskPreloadManifest::Set(UClass* InOwnerClass, TArray<TSoftClassPtr<UBtf_TaskForge>> InTaskClasses)
+{
+    if (NOT IsValid(InOwnerClass))
+    { return; }
+
+    auto* Manifest = FindObjectFast<UBtf_TaskPreloadManifest>(InOwnerClass, ManifestName);
+    if (InTaskClasses.IsEmpty())
+    {
+        if (Manifest != nullptr)
+        {
+            Manifest->Rename(nullptr, GetTransientPackage(), REN_DontCreateRedirectors | REN_DoNotDirty | REN_NonTransactional);
+        }
+        return;
+    }
+
+    if (Manifest == nullptr)
+    {
+        Manifest = NewObject<UBtf_TaskPreloadManifest>(InOwnerClass, ManifestName);
+    }
+
+    Manifest->TaskClasses = MoveTemp(InTaskClasses);
+}
+#endif
+
+// --------------------------------------------------------------------------------------------------------------------
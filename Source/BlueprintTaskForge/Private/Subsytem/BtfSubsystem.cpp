@@ -10,68 +10,1094 @@
 
 #include "Subsystem/BtfSubsystem.h"
 #include "BtfTaskForge.h"
+#include "Settings/BtfRuntimeSettings.h"
+#include "BtfTaskPreloadManifest.h"
+
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/AssetManager.h"
+#include "Engine/Level.h"
+#include "Engine/LevelScriptActor.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Algo/Sort.h"
+
+// --------------------------------------------------------------------------------------------------------------------
+
+namespace
+{
+    constexpr auto MinStaleOuterSweepThreshold = 64;
+
+    bool IsStaleOuter(const TWeakObjectPtr<UObject>& InOuter) { return NOT InOuter.IsValid(); }
+    bool IsStaleOuter(const TObjectKey<UObject>& InOuter) { return InOuter.ResolveObjectPtr() == nullptr; }
+
+    // Outers are not required to tell us when they go away. The entries of destroyed actors are dropped through their
+    // lifetime hook, any other stale entry is swept once the map has doubled since the last sweep
+    template <typename TOuterMap>
+    void SweepStaleOuters(TOuterMap& InOutMap, int32& InOutSweepThreshold)
+    {
+        if (InOutMap.Num() < FMath::Max(InOutSweepThreshold, MinStaleOuterSweepThreshold))
+        { return; }
+
+        for (auto It = InOutMap.CreateIterator(); It; ++It)
+        {
+            if (IsStaleOuter(It.Key()))
+            { It.RemoveCurrent(); }
+        }
+
+        InOutSweepThreshold = InOutMap.Num() * 2;
+    }
+}
 
 // --------------------------------------------------------------------------------------------------------------------
 
-void UBtf_WorldSubsystem::Deinitialize()
+void UBtf_WorldSubsystem::PostInitialize()
+{
+    Super::PostInitialize();
+
+    WorldBeginTearDownHandle = FWorldDelegates::OnWorldBeginTearDown.AddUObject(this, &UBtf_WorldSubsystem::OnWorldBeginTearDown);
+    PreLevelRemovedFromWorldHandle = FWorldDelegates::PreLevelRemovedFromWorld.AddUObject(this, &UBtf_WorldSubsystem::OnLevelRemovedFromWorld);
+
+    const auto* World = GetWorld();
+    if (NOT GetDefault<UBtf_RuntimeSettings>()->PreloadTaskClasses || NOT IsValid(World) || NOT World->IsGameWorld())
+    { return; }
+
+    for (const auto* Level : World->GetLevels())
+    {
+        PreloadLevelTaskClasses(Level);
+    }
+
+    LevelAddedToWorldHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UBtf_WorldSubsystem::OnLevelAddedToWorld);
+}
+
+void UBtf_WorldSubsystem::Deinitialize()
+{
+    // Normally already done when the world began its tear down, this catches worlds cleaned up without one
+    TeardownTasks(nullptr);
+
+    FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedToWorldHandle);
+    FWorldDelegates::OnWorldBeginTearDown.Remove(WorldBeginTearDownHandle);
+    FWorldDelegates::PreLevelRemovedFromWorld.Remove(PreLevelRemovedFromWorldHandle);
+
+    for (const auto& Handle : TaskClassPreloadHandles)
+    {
+        if (Handle.IsValid())
+        {
+            Handle->CancelHandle();
+        }
+    }
+    TaskClassPreloadHandles.Empty();
+    PreloadedTaskClasses.Empty();
+
+#if WITH_EDITOR
+    if (IsValid(GEngine))
+    {
+        if (const auto& BlueprintTaskEngineSubsystem = GEngine->GetEngineSubsystem<UBtf_EngineSubsystem>();
+            IsValid(BlueprintTaskEngineSubsystem))
+        {
+            BlueprintTaskEngineSubsystem->Clear();
+        }
+    }
+#endif
+
+    for (auto& [Class, Pool] : TaskPools)
+    {
+        for (const auto& Task : Pool.Tasks)
+        {
+            if (IsValid(Task))
+            {
+                Task->OnDestroy();
+            }
+        }
+    }
+    TaskPools.Empty();
+    NativeTickingTasks.Empty();
+    TaskRegistry.Reset();
+    ActorsWithLifetimeHook.Empty();
+    PerOuterTaskInstances.Empty();
+    PerOuterTaskInstanceOutersByActor.Empty();
+    NodeTaskSlotsPerOuter.Empty();
+    TaskNameCountersPerOuter.Empty();
+#if !UE_BUILD_SHIPPING
+    TaskDebugNames.Empty();
+#endif
+
+    Super::Deinitialize();
+}
+
+void UBtf_WorldSubsystem::Tick(const float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    TickNativeTasks(DeltaTime);
+    DrainDeferredDeactivations(GetDefault<UBtf_RuntimeSettings>()->DeferredDeactivationBudgetMs / 1000.0);
+}
+
+bool UBtf_WorldSubsystem::IsTickable() const
+{
+    return NOT NativeTickingTasks.IsEmpty() || NOT DeferredDeactivations.IsEmpty();
+}
+
+TStatId UBtf_WorldSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UBtf_WorldSubsystem, STATGROUP_Tickables);
+}
+
+void UBtf_WorldSubsystem::StartNativeTick(UBtf_TaskForge* InTask)
+{
+    if (NOT IsValid(InTask) || InTask->NativeTickIndex != INDEX_NONE)
+    { return; }
+
+    InTask->NativeTickIndex = NativeTickingTasks.Add(InTask);
+}
+
+void UBtf_WorldSubsystem::StopNativeTick(UBtf_TaskForge* InTask)
+{
+    if (InTask == nullptr || NOT NativeTickingTasks.IsValidIndex(InTask->NativeTickIndex))
+    { return; }
+
+    const auto Index = InTask->NativeTickIndex;
+    InTask->NativeTickIndex = INDEX_NONE;
+
+    if (NativeTickingTasks[Index] != InTask)
+    { return; }
+
+    // Removing while ticking would move a task that has not ticked yet behind the ones that have
+    if (IsTickingNativeTasks)
+    {
+        NativeTickingTasks[Index].Reset();
+        return;
+    }
+
+    const auto LastIndex = NativeTickingTasks.Num() - 1;
+    NativeTickingTasks.RemoveAtSwap(Index, EAllowShrinking::No);
+    if (Index == LastIndex)
+    { return; }
+
+    if (auto* MovedTask = NativeTickingTasks[Index].Get();
+        MovedTask != nullptr && MovedTask->NativeTickIndex == LastIndex)
+    {
+        MovedTask->NativeTickIndex = Index;
+    }
+}
+
+void UBtf_WorldSubsystem::TickNativeTasks(const float InDeltaTime)
+{
+    QUICK_SCOPE_CYCLE_COUNTER(TaskNode_NativeTick)
+
+    if (NativeTickingTasks.IsEmpty())
+    { return; }
+
+    // Tasks started from a tick are appended past NumTasks and first tick next frame
+    IsTickingNativeTasks = true;
+    const auto NumTasks = NativeTickingTasks.Num();
+    for (auto Index = 0; Index < NumTasks; ++Index)
+    {
+        auto* Task = NativeTickingTasks[Index].Get();
+        if (Task == nullptr || Task->NativeTickIndex != Index || NOT Task->IsActive)
+        { continue; }
+
+        Task->NativeDispatch->Tick(*Task, InDeltaTime);
+    }
+    IsTickingNativeTasks = false;
+
+    auto NumKept = 0;
+    for (auto Index = 0; Index < NativeTickingTasks.Num(); ++Index)
+    {
+        auto* Task = NativeTickingTasks[Index].Get();
+        if (Task == nullptr || Task->NativeTickIndex != Index)
+        { continue; }
+
+        Task->NativeTickIndex = NumKept;
+        NativeTickingTasks[NumKept++] = NativeTickingTasks[Index];
+    }
+    NativeTickingTasks.SetNum(NumKept, EAllowShrinking::No);
+}
+
+void UBtf_WorldSubsystem::BindOuterLifetime(UObject* InOuter)
+{
+    if (NOT IsValid(InOuter))
+    { return; }
+
+    auto* Actor = Cast<AActor>(InOuter);
+    if (Actor == nullptr)
+    {
+        Actor = InOuter->GetTypedOuter<AActor>();
+    }
+
+    if (NOT IsValid(Actor))
+    { return; }
+
+    if (auto AlreadyBound = false;
+        ActorsWithLifetimeHook.Add(Actor, &AlreadyBound), AlreadyBound)
+    { return; }
+
+    Actor->OnDestroyed.AddDynamic(this, &UBtf_WorldSubsystem::OnOuterActorDestroyed);
+    Actor->OnEndPlay.AddDynamic(this, &UBtf_WorldSubsystem::OnOuterActorEndPlay);
+}
+
+void UBtf_WorldSubsystem::UnbindOuterLifetime(AActor* InActor)
+{
+    if (ActorsWithLifetimeHook.Remove(InActor) == 0 || NOT IsValid(InActor))
+    { return; }
+
+    InActor->OnDestroyed.RemoveDynamic(this, &UBtf_WorldSubsystem::OnOuterActorDestroyed);
+    InActor->OnEndPlay.RemoveDynamic(this, &UBtf_WorldSubsystem::OnOuterActorEndPlay);
+}
+
+void UBtf_WorldSubsystem::OnOuterActorEndPlay(AActor* InActor, const EEndPlayReason::Type InEndPlayReason)
+{
+    // Destroyed actors are handled by OnOuterActorDestroyed, which follows
+    if (InEndPlayReason == EEndPlayReason::Destroyed)
+    { return; }
+
+    UnbindOuterLifetime(InActor);
+}
+
+void UBtf_WorldSubsystem::OnOuterActorDestroyed(AActor* InActor)
+{
+    QUICK_SCOPE_CYCLE_COUNTER(OnOuterActorDestroyed)
+
+    UnbindOuterLifetime(InActor);
+
+    auto Tasks = TArray<TWeakObjectPtr<UBtf_TaskForge>>{};
+    CollectTasksRelatedToObject(InActor, Tasks);
+
+    // Instances kept for the next execution on their outer are not tracked while inactive
+    auto InstanceOuters = TArray<TWeakObjectPtr<UObject>>{};
+    PerOuterTaskInstanceOutersByActor.RemoveAndCopyValue(InActor, InstanceOuters);
+    for (const auto& Outer : InstanceOuters)
+    {
+        const auto* Instances = PerOuterTaskInstances.Find(Outer);
+        if (Instances == nullptr)
+        { continue; }
+
+        for (const auto& [Class, Task] : Instances->Tasks)
+        {
+            if (IsValid(Task) && NOT Task->Get_IsActive())
+            {
+                Tasks.Add(Task);
+            }
+        }
+    }
+
+    for (const auto& WeakTask : Tasks)
+    {
+        if (auto* Task = WeakTask.Get();
+            IsValid(Task) && Task->IsIn(InActor))
+        {
+            Task->OnActorOuterDestroyed(InActor);
+        }
+    }
+}
+
+void UBtf_WorldSubsystem::TeardownTasks(const ULevel* InLevel)
+{
+    QUICK_SCOPE_CYCLE_COUNTER(TeardownTasks)
+
+    const auto IsDeparting = [InLevel](const UObject* InObject)
+    {
+        return InLevel == nullptr || (InObject != nullptr && InObject->IsIn(InLevel));
+    };
+
+    // The actors of queued tasks are already destroyed, they are deactivated as such rather than torn down
+    DrainDeferredDeactivations(-1.0);
+
+    auto Tasks = TArray<UBtf_TaskForge*>{};
+    if (InLevel == nullptr)
+    {
+        Tasks.Reserve(TaskRegistry.Num());
+    }
+
+    TaskRegistry.ForEachTask([&](UBtf_TaskForge& InTask)
+    {
+        if (IsDeparting(&InTask))
+        {
+            Tasks.Add(&InTask);
+        }
+        return true;
+    });
+
+    for (auto It = PerOuterTaskInstances.CreateIterator(); It; ++It)
+    {
+        if (const auto* Outer = It.Key().Get();
+            Outer != nullptr && NOT IsDeparting(Outer))
+        { continue; }
+
+        for (const auto& [Class, Task] : It.Value().Tasks)
+        {
+            if (IsValid(Task) && NOT Task->Get_IsActive())
+            {
+                Tasks.Add(Task);
+            }
+        }
+        It.RemoveCurrent();
+    }
+
+    for (auto It = PerOuterTaskInstanceOutersByActor.CreateIterator(); It; ++It)
+    {
+        if (const auto* Actor = It.Key().ResolveObjectPtr();
+            Actor == nullptr || IsDeparting(Actor))
+        { It.RemoveCurrent(); }
+    }
+
+    // Dropped without activating the queued executions, their outers are going away too
+    for (auto It = NodeTaskSlotsPerOuter.CreateIterator(); It; ++It)
+    {
+        if (const auto* Outer = It.Key().Get();
+            Outer == nullptr || IsDeparting(Outer))
+        { It.RemoveCurrent(); }
+    }
+
+    if (InLevel == nullptr)
+    {
+        TaskRegistry.Reset();
+        ActorsWithLifetimeHook.Empty();
+        TaskNameCountersPerOuter.Empty();
+#if !UE_BUILD_SHIPPING
+        TaskDebugNames.Empty();
+#endif
+    }
+    else
+    {
+        for (auto* Task : Tasks)
+        {
+            UntrackTask(Task);
+        }
+
+        for (auto It = ActorsWithLifetimeHook.CreateIterator(); It; ++It)
+        {
+            if (const auto* Actor = It->ResolveObjectPtr();
+                Actor == nullptr || IsDeparting(Actor))
+            { It.RemoveCurrent(); }
+        }
+
+        for (auto It = TaskNameCountersPerOuter.CreateIterator(); It; ++It)
+        {
+            if (const auto* Outer = It.Key().ResolveObjectPtr();
+                Outer == nullptr || IsDeparting(Outer))
+            { It.RemoveCurrent(); }
+        }
+    }
+
+    for (auto* Task : Tasks)
+    {
+        if (IsValid(Task))
+        {
+            Task->ReleaseForTeardown();
+        }
+    }
+}
+
+void UBtf_WorldSubsystem::OnWorldBeginTearDown(UWorld* InWorld)
+{
+    if (InWorld == GetWorld())
+    {
+        TeardownTasks(nullptr);
+    }
+}
+
+void UBtf_WorldSubsystem::OnLevelRemovedFromWorld(ULevel* InLevel, UWorld* InWorld)
+{
+    // A null level means every level of the world
+    if (InWorld == GetWorld())
+    {
+        TeardownTasks(InLevel);
+    }
+}
+
+void UBtf_WorldSubsystem::QueueDeferredDeactivation(UBtf_TaskForge* InTask)
+{
+    if (NOT IsValid(InTask))
+    { return; }
+
+    DeferredDeactivations.Add(InTask);
+    DeferredDeactivationsSorted = false;
+}
+
+void UBtf_WorldSubsystem::DrainDeferredDeactivations(const double InBudgetSeconds)
+{
+    QUICK_SCOPE_CYCLE_COUNTER(DrainDeferredDeactivations)
+
+    if (DeferredDeactivations.IsEmpty())
+    { return; }
+
+    // Tasks of the same class run the same code on the same kind of data, deactivating them back to back
+    // keeps both warm. The queue is drained from its end, the order between classes does not matter.
+    if (NOT DeferredDeactivationsSorted)
+    {
+        Algo::SortBy(DeferredDeactivations, [](const TObjectPtr<UBtf_TaskForge>& InTask)
+        {
+            return InTask != nullptr ? InTask->GetClass() : nullptr;
+        });
+        DeferredDeactivationsSorted = true;
+    }
+
+    const auto EndTime = FPlatformTime::Seconds() + InBudgetSeconds;
+    do
+    {
+        auto* Task = DeferredDeactivations.Pop(EAllowShrinking::No).Get();
+
+        // Deactivating may queue more tasks (sorted on the next drain) or deactivate queued ones (which clears their flag)
+        if (IsValid(Task) && Task->IsPendingDeactivation)
+        {
+            Task->DeactivateForDestroyedOuter();
+        }
+    }
+    while (NOT DeferredDeactivations.IsEmpty() && (InBudgetSeconds < 0.0 || FPlatformTime::Seconds() < EndTime));
+}
+
+void UBtf_WorldSubsystem::TrackTask(UBtf_TaskForge* Task)
+{
+    QUICK_SCOPE_CYCLE_COUNTER(TrackTask)
+
+    if (NOT IsValid(Task))
+    { return; }
+
+    TaskRegistry.Add(Task);
+}
+
+void UBtf_WorldSubsystem::TrackTasks(TConstArrayView<UBtf_TaskForge*> InTasks)
+{
+    QUICK_SCOPE_CYCLE_COUNTER(TrackTasks)
+
+    TaskRegistry.Reserve(InTasks.Num());
+
+    for (auto* Task : InTasks)
+    {
+        if (IsValid(Task))
+        {
+            TaskRegistry.Add(Task);
+        }
+    }
+}
+
+void UBtf_WorldSubsystem::UntrackTask(UBtf_TaskForge* Task)
+{
+    QUICK_SCOPE_CYCLE_COUNTER(UntrackTask)
+
+    if (NOT IsValid(Task))
+    { return; }
+
+    TaskRegistry.Remove(Task);
+}
+
+TMap<TWeakObjectPtr<UObject>, FBtf_OutersBlueprintTasksArrayWrapper> UBtf_WorldSubsystem::GetTaskTree()
+{
+    auto TaskTree = TMap<TWeakObjectPtr<UObject>, FBtf_OutersBlueprintTasksArrayWrapper>{};
+
+    TaskRegistry.ForEachTask([&](UBtf_TaskForge& InTask)
+    {
+        TaskTree.FindOrAdd(InTask.GetOuter()).Tasks.Add(&InTask);
+        return true;
+    });
+
+    return TaskTree;
+}
+
+FBtf_TaskHandle UBtf_WorldSubsystem::Get_TaskHandle(const UBtf_TaskForge* InTask) const
+{
+    return TaskRegistry.Get_Handle(InTask);
+}
+
+UBtf_TaskForge* UBtf_WorldSubsystem::ResolveTaskHandle(const FBtf_TaskHandle& InHandle) const
+{
+    return TaskRegistry.Resolve(InHandle);
+}
+
+void UBtf_WorldSubsystem::ForEachTask(const FBtf_TaskRegistry::FTaskVisitor InVisitor) const
+{
+    TaskRegistry.ForEachTask(InVisitor);
+}
+
+void UBtf_WorldSubsystem::ForEachOuter(const FBtf_TaskRegistry::FOuterVisitor InVisitor) const
+{
+    TaskRegistry.ForEachOuter(InVisitor);
+}
+
+void UBtf_WorldSubsystem::ForEachTaskOfOuter(const UObject* InOuter, const FBtf_TaskRegistry::FTaskVisitor InVisitor) const
+{
+    TaskRegistry.ForEachTaskOfOuter(InOuter, InVisitor);
+}
+
+void UBtf_WorldSubsystem::ForEachTaskOfClass(const UClass* InClass, const bool InIncludeSubclasses, const FBtf_TaskRegistry::FTaskVisitor InVisitor) const
+{
+    TaskRegistry.ForEachTaskOfClass(InClass, InIncludeSubclasses, InVisitor);
+}
+
+void UBtf_WorldSubsystem::ForEachTaskWithTag(const FGameplayTag& InTag, const FBtf_TaskRegistry::FTaskVisitor InVisitor) const
+{
+    TaskRegistry.ForEachTaskWithTag(InTag, InVisitor);
+}
+
+void UBtf_WorldSubsystem::GetActiveTasksOfClass(const TSubclassOf<UBtf_TaskForge> Class, const bool IncludeSubclasses, TArray<UBtf_TaskForge*>& OutTasks) const
+{
+    QUICK_SCOPE_CYCLE_COUNTER(GetActiveTasksOfClass)
+
+    OutTasks.Reset();
+    TaskRegistry.ForEachTaskOfClass(Class, IncludeSubclasses, [&](UBtf_TaskForge& InTask)
+    {
+        OutTasks.Add(&InTask);
+        return true;
+    });
+}
+
+void UBtf_WorldSubsystem::GetActiveTasksOfOuter(const UObject* Outer, TArray<UBtf_TaskForge*>& OutTasks) const
+{
+    QUICK_SCOPE_CYCLE_COUNTER(GetActiveTasksOfOuter)
+
+    OutTasks.Reset();
+    TaskRegistry.ForEachTaskOfOuter(Outer, [&](UBtf_TaskForge& InTask)
+    {
+        OutTasks.Add(&InTask);
+        return true;
+    });
+}
+
+int32 UBtf_WorldSubsystem::CountActiveTasksOfClass(const TSubclassOf<UBtf_TaskForge> Class, const bool IncludeSubclasses) const
+{
+    return TaskRegistry.Num_TasksOfClass(Class, IncludeSubclasses);
+}
+
+int32 UBtf_WorldSubsystem::CountActiveTasksOfOuter(const UObject* Outer) const
+{
+    return TaskRegistry.Num_TasksOfOuter(Outer);
+}
+
+void UBtf_WorldSubsystem::GetActiveTasksWithTag(const FGameplayTag Tag, TArray<UBtf_TaskForge*>& OutTasks, const UObject* Outer) const
+{
+    QUICK_SCOPE_CYCLE_COUNTER(GetActiveTasksWithTag)
+
+    OutTasks.Reset();
+    TaskRegistry.ForEachTaskWithTag(Tag, [&](UBtf_TaskForge& InTask)
+    {
+        if (Outer == nullptr || InTask.IsIn(Outer))
+        {
+            OutTasks.Add(&InTask);
+        }
+        return true;
+    });
+}
+
+int32 UBtf_WorldSubsystem::DeactivateTasksWithTag(const FGameplayTag Tag, const UObject* Outer)
+{
+    QUICK_SCOPE_CYCLE_COUNTER(DeactivateTasksWithTag)
+
+    // Collected up front, deactivating a task changes the registry and may deactivate other tasks
+    auto TasksToDeactivate = TArray<TWeakObjectPtr<UBtf_TaskForge>>{};
+    TaskRegistry.ForEachTaskWithTag(Tag, [&](UBtf_TaskForge& InTask)
+    {
+        if (Outer == nullptr || InTask.IsIn(Outer))
+        {
+            TasksToDeactivate.Add(&InTask);
+        }
+        return true;
+    });
+
+    auto NumDeactivated = 0;
+    for (const auto& WeakTask : TasksToDeactivate)
+    {
+        // An earlier deactivation may already have ended the task, or pooled it and handed it out again
+        // under another outer and other tags
+        if (auto* Task = WeakTask.Get();
+            IsValid(Task) && TaskRegistry.Contains(Task) && Task->TaskTags.HasTag(Tag) && (Outer == nullptr || Task->IsIn(Outer)))
+        {
+            Task->Deactivate();
+            ++NumDeactivated;
+        }
+    }
+
+    return NumDeactivated;
+}
+
+int32 UBtf_WorldSubsystem::CountTasksWithTag(const FGameplayTag Tag, const UObject* Outer) const
+{
+    auto NumTasks = 0;
+    TaskRegistry.ForEachTaskWithTag(Tag, [&](const UBtf_TaskForge& InTask)
+    {
+        if (Outer == nullptr || InTask.IsIn(Outer))
+        {
+            ++NumTasks;
+        }
+        return true;
+    });
+
+    return NumTasks;
+}
+
+void UBtf_WorldSubsystem::CollectTasksRelatedToObject(const UObject* InObject, TArray<TWeakObjectPtr<UBtf_TaskForge>>& OutTasks) const
+{
+    QUICK_SCOPE_CYCLE_COUNTER(CollectTasksRelatedToObject)
+
+    if (NOT IsValid(InObject))
+    { return; }
+
+    auto RelatedOuters = TArray<UObject*, TInlineAllocator<8>>{};
+    const auto CollectRelatedOuter = [&](UObject& InOuter, int32)
+    {
+        if (&InOuter == InObject || InOuter.IsIn(InObject))
+        {
+            RelatedOuters.Add(&InOuter);
+        }
+        return true;
+    };
+
+    // Only the outers owned by the same actor as @InObject can be nested in it. Anything else (a level, the world)
+    // may contain actors, so every outer is looked at.
+    if (const auto* OwningActor = FBtf_TaskRegistry::Get_OwningActor(InObject);
+        OwningActor != nullptr)
+    {
+        TaskRegistry.ForEachOuterOfActor(OwningActor, CollectRelatedOuter);
+    }
+    else
+    {
+        TaskRegistry.ForEachOuter(CollectRelatedOuter);
+    }
+
+    // An execution is only queued behind an active task of the same node and outer, which is tracked
+    for (auto* Outer : RelatedOuters)
+    {
+        const auto* NodeTaskSlots = NodeTaskSlotsPerOuter.Find(Outer);
+        if (NodeTaskSlots == nullptr)
+        { continue; }
+
+        for (const auto& [NodeGuid, Slot] : NodeTaskSlots->SlotsByNodeGuid)
+        {
+            for (auto Index = Slot.FirstQueuedTask; Index < Slot.QueuedTasks.Num(); ++Index)
+            {
+                if (const auto& QueuedTask = Slot.QueuedTasks[Index];
+                    IsValid(QueuedTask) && QueuedTask->NodeQueueTicket == Slot.QueuedTickets[Index])
+                {
+                    OutTasks.Add(QueuedTask);
+                }
+            }
+        }
+    }
+
+    for (auto* Outer : RelatedOuters)
+    {
+        TaskRegistry.ForEachTaskOfOuter(Outer, [&](UBtf_TaskForge& InTask)
+        {
+            OutTasks.Add(&InTask);
+            return true;
+        });
+    }
+}
+
+UBtf_TaskForge* UBtf_WorldSubsystem::AcquirePooledTask(const UClass* InClass, UObject* InOuter, const UBtf_TaskForge* InArchetype)
 {
-#if WITH_EDITOR
-    if (IsValid(GEngine))
+    QUICK_SCOPE_CYCLE_COUNTER(AcquirePooledTask)
+
+    auto* Pool = TaskPools.Find(InClass);
+    if (Pool == nullptr)
+    { return nullptr; }
+
+    while (NOT Pool->Tasks.IsEmpty())
     {
-        if (const auto& BlueprintTaskEngineSubsystem = GEngine->GetEngineSubsystem<UBtf_EngineSubsystem>();
-            IsValid(BlueprintTaskEngineSubsystem))
+        auto* Task = Pool->Tasks.Pop(EAllowShrinking::No).Get();
+        if (NOT IsValid(Task))
+        { continue; }
+
+        Task->Rename(nullptr, InOuter, REN_DontCreateRedirectors | REN_DoNotDirty | REN_NonTransactional);
+        Task->ResetForReuse(IsValid(InArchetype) ? InArchetype : InClass->GetDefaultObject<UBtf_TaskForge>());
+        return Task;
+    }
+
+    return nullptr;
+}
+
+bool UBtf_WorldSubsystem::ReturnTaskToPool(UBtf_TaskForge* InTask)
+{
+    QUICK_SCOPE_CYCLE_COUNTER(ReturnTaskToPool)
+
+    if (NOT IsValid(InTask))
+    { return false; }
+
+    auto& Pool = TaskPools.FindOrAdd(InTask->GetClass());
+    if (Pool.Tasks.Num() >= GetDefault<UBtf_RuntimeSettings>()->MaxPooledTasksPerClass)
+    { return false; }
+
+    InTask->OnReturnedToPool();
+    UnregisterTaskName(InTask);
+
+    // Parking the task under the subsystem keeps it in this world and detaches it from its previous outer,
+    // so outer based lookups such as DeactivateAllTasksRelatedToObject no longer find it
+    InTask->Rename(nullptr, this, REN_DontCreateRedirectors | REN_DoNotDirty | REN_NonTransactional);
+    Pool.Tasks.Add(InTask);
+
+    return true;
+}
+
+UBtf_TaskForge* UBtf_WorldSubsystem::FindPerOuterTask(UObject* InOuter, const UClass* InClass) const
+{
+    if (const auto* TaskInstances = PerOuterTaskInstances.Find(InOuter);
+        TaskInstances != nullptr)
+    {
+        if (const auto* FoundTask = TaskInstances->Tasks.Find(InClass);
+            FoundTask != nullptr && IsValid(*FoundTask))
         {
-            BlueprintTaskEngineSubsystem->Clear();
+            return *FoundTask;
+        }
+    }
+
+    return nullptr;
+}
+
+void UBtf_WorldSubsystem::RegisterPerOuterTask(UBtf_TaskForge* InTask)
+{
+    if (NOT IsValid(InTask))
+    { return; }
+
+    auto* TaskInstances = PerOuterTaskInstances.Find(InTask->GetOuter());
+    if (TaskInstances == nullptr)
+    {
+        SweepStaleOuters(PerOuterTaskInstances, PerOuterTaskInstancesSweepThreshold);
+        TaskInstances = &PerOuterTaskInstances.Add(InTask->GetOuter());
+
+        if (const auto* Actor = FBtf_TaskRegistry::Get_OwningActor(InTask->GetOuter());
+            Actor != nullptr)
+        {
+            PerOuterTaskInstanceOutersByActor.FindOrAdd(Actor).Add(InTask->GetOuter());
+        }
+    }
+
+    TaskInstances->Tasks.Add(InTask->GetClass(), InTask);
+}
+
+void UBtf_WorldSubsystem::ReleasePerOuterTasks(UObject* InOuter)
+{
+    if (PerOuterTaskInstances.Remove(InOuter) == 0)
+    { return; }
+
+    const auto* Actor = FBtf_TaskRegistry::Get_OwningActor(InOuter);
+    if (auto* InstanceOuters = PerOuterTaskInstanceOutersByActor.Find(Actor);
+        InstanceOuters != nullptr)
+    {
+        InstanceOuters->RemoveSingleSwap(InOuter, EAllowShrinking::No);
+        if (InstanceOuters->IsEmpty())
+        {
+            PerOuterTaskInstanceOutersByActor.Remove(Actor);
+        }
+    }
+}
+
+UBtf_TaskForge* UBtf_WorldSubsystem::Get_ActiveNodeTask(UObject* InOuter, const FGuid& InNodeGuid) const
+{
+    if (const auto* NodeTaskSlots = NodeTaskSlotsPerOuter.Find(InOuter);
+        NodeTaskSlots != nullptr)
+    {
+        if (const auto* Slot = NodeTaskSlots->SlotsByNodeGuid.Find(InNodeGuid);
+            Slot != nullptr && IsValid(Slot->ActiveTask))
+        {
+            return Slot->ActiveTask;
+        }
+    }
+
+    return nullptr;
+}
+
+bool UBtf_WorldSubsystem::ClaimNodeTaskSlot(UBtf_TaskForge* InTask)
+{
+    QUICK_SCOPE_CYCLE_COUNTER(ClaimNodeTaskSlot)
+
+    if (NOT IsValid(InTask) || NOT InTask->Get_ReentrancyNodeGuid().IsValid())
+    { return true; }
+
+    InTask->ReentrancyOuter = InTask->GetOuter();
+
+    auto* NodeTaskSlots = NodeTaskSlotsPerOuter.Find(InTask->ReentrancyOuter);
+    if (NodeTaskSlots == nullptr)
+    {
+        SweepStaleOuters(NodeTaskSlotsPerOuter, NodeTaskSlotsSweepThreshold);
+        NodeTaskSlots = &NodeTaskSlotsPerOuter.Add(InTask->ReentrancyOuter);
+    }
+
+    auto& Slot = NodeTaskSlots->SlotsByNodeGuid.FindOrAdd(InTask->Get_ReentrancyNodeGuid());
+    if (Slot.ActiveTask == InTask || NOT IsValid(Slot.ActiveTask))
+    {
+        Slot.ActiveTask = InTask;
+        return true;
+    }
+
+    if (InTask->Get_ReentrancyPolicy() == EBtf_TaskReentrancyPolicy::Queue)
+    {
+        // Activating a task again while it waits for its turn does not queue it twice
+        if (InTask->NodeQueueTicket != INDEX_NONE)
+        { return false; }
+
+        if (Slot.FirstQueuedTask > 0 && Slot.FirstQueuedTask * 2 >= Slot.QueuedTasks.Num())
+        {
+            Slot.QueuedTasks.RemoveAt(0, Slot.FirstQueuedTask, EAllowShrinking::No);
+            Slot.QueuedTickets.RemoveAt(0, Slot.FirstQueuedTask, EAllowShrinking::No);
+            Slot.FirstQueuedTask = 0;
+        }
+
+        InTask->NodeQueueTicket = Slot.NextTicket++;
+        Slot.QueuedTasks.Add(InTask);
+        Slot.QueuedTickets.Add(InTask->NodeQueueTicket);
+        return false;
+    }
+
+    // The node factory already took care of the previous task for the other policies
+    Slot.ActiveTask = InTask;
+    return true;
+}
+
+void UBtf_WorldSubsystem::ReleaseNodeTaskSlot(UBtf_TaskForge* InTask)
+{
+    QUICK_SCOPE_CYCLE_COUNTER(ReleaseNodeTaskSlot)
+
+    if (InTask == nullptr || NOT InTask->Get_ReentrancyNodeGuid().IsValid())
+    { return; }
+
+    // Not the current outer, a pooled task is moved under the subsystem before it releases its slot
+    const auto SlotOuter = InTask->ReentrancyOuter;
+    InTask->ReentrancyOuter.Reset();
+
+    auto* NodeTaskSlots = NodeTaskSlotsPerOuter.Find(SlotOuter);
+    if (NodeTaskSlots == nullptr)
+    { return; }
+
+    auto* Slot = NodeTaskSlots->SlotsByNodeGuid.Find(InTask->Get_ReentrancyNodeGuid());
+    if (Slot == nullptr)
+    { return; }
+
+    if (Slot->ActiveTask != InTask)
+    {
+        InTask->NodeQueueTicket = INDEX_NONE;
+        return;
+    }
+
+    Slot->ActiveTask = nullptr;
+
+    while (Slot->FirstQueuedTask < Slot->QueuedTasks.Num())
+    {
+        const auto Index = Slot->FirstQueuedTask++;
+        auto* NextTask = Slot->QueuedTasks[Index].Get();
+        Slot->QueuedTasks[Index] = nullptr;
+
+        // Dropped from the queue since, possibly queued again further back
+        if (NOT IsValid(NextTask) || NextTask->NodeQueueTicket != Slot->QueuedTickets[Index])
+        { continue; }
+
+        NextTask->NodeQueueTicket = INDEX_NONE;
+        if (IsValid(NextTask->GetOuter()))
+        {
+            Slot->ActiveTask = NextTask;
+
+            // The slot may be released (and the map modified) again from within the activation
+            NextTask->Activate();
+            return;
+        }
+    }
+
+    NodeTaskSlots->SlotsByNodeGuid.Remove(InTask->Get_ReentrancyNodeGuid());
+    if (NodeTaskSlots->SlotsByNodeGuid.IsEmpty())
+    {
+        NodeTaskSlotsPerOuter.Remove(SlotOuter);
+    }
+}
+
+FName UBtf_WorldSubsystem::MakeTaskName(UObject* InOuter, const UClass* InClass)
+{
+    QUICK_SCOPE_CYCLE_COUNTER(MakeTaskName)
+
+    switch (GetDefault<UBtf_RuntimeSettings>()->TaskNamingMode)
+    {
+        case EBtf_TaskNamingMode::GloballyUnique:
+        {
+            return MakeUniqueObjectName(InOuter, InClass, InClass->GetFName(), EUniqueObjectNameOptions::GloballyUnique);
+        }
+        case EBtf_TaskNamingMode::PerOuterCounter:
+        {
+            // Numbered names share the class name entry, so this does not grow the name table
+            auto* FoundCounter = TaskNameCountersPerOuter.Find(InOuter);
+            if (FoundCounter == nullptr)
+            {
+                SweepStaleOuters(TaskNameCountersPerOuter, TaskNameCountersSweepThreshold);
+                FoundCounter = &TaskNameCountersPerOuter.Add(InOuter);
+            }
+
+            auto& Counter = *FoundCounter;
+            auto TaskName = FName(InClass->GetFName(), NAME_EXTERNAL_TO_INTERNAL(Counter.NextNumber++));
+            while (StaticFindObjectFast(nullptr, InOuter, TaskName) != nullptr)
+            {
+                TaskName = FName(InClass->GetFName(), NAME_EXTERNAL_TO_INTERNAL(Counter.NextNumber++));
+            }
+            return TaskName;
+        }
+        case EBtf_TaskNamingMode::Anonymous:
+        case EBtf_TaskNamingMode::DebugNames:
+        default:
+        {
+            return NAME_None;
+        }
+    }
+}
+
+void UBtf_WorldSubsystem::RegisterTaskName(UBtf_TaskForge* InTask)
+{
+    if (NOT IsValid(InTask))
+    { return; }
+
+    const auto TaskNamingMode = GetDefault<UBtf_RuntimeSettings>()->TaskNamingMode;
+    if (TaskNamingMode == EBtf_TaskNamingMode::PerOuterCounter)
+    {
+        if (auto* Counter = TaskNameCountersPerOuter.Find(InTask->GetOuter());
+            Counter != nullptr)
+        {
+            ++Counter->NumNamedTasks;
+            InTask->NameCounterOuter = InTask->GetOuter();
         }
     }
+
+#if !UE_BUILD_SHIPPING
+    if (TaskNamingMode != EBtf_TaskNamingMode::DebugNames)
+    { return; }
+
+    TaskDebugNames.Add(InTask, FString::Printf(TEXT("%s (%s)"), *InTask->GetClass()->GetName(), *GetNameSafe(InTask->GetOuter())));
 #endif
+}
 
-    Super::Deinitialize();
+void UBtf_WorldSubsystem::UnregisterTaskName(UBtf_TaskForge* InTask)
+{
+    if (InTask == nullptr)
+    { return; }
+
+    // Names of finished tasks may be handed out again, MakeTaskName skips the ones still in use
+    if (const auto CounterOuter = InTask->NameCounterOuter;
+        CounterOuter != TObjectKey<UObject>{})
+    {
+        InTask->NameCounterOuter = TObjectKey<UObject>{};
+        if (auto* Counter = TaskNameCountersPerOuter.Find(CounterOuter);
+            Counter != nullptr && --Counter->NumNamedTasks <= 0)
+        {
+            TaskNameCountersPerOuter.Remove(CounterOuter);
+        }
+    }
+
+#if !UE_BUILD_SHIPPING
+    TaskDebugNames.Remove(InTask);
+#endif
 }
 
-void UBtf_WorldSubsystem::TrackTask(UBtf_TaskForge* Task)
+FString UBtf_WorldSubsystem::Get_TaskDebugName(const UBtf_TaskForge* InTask) const
 {
-    QUICK_SCOPE_CYCLE_COUNTER(TrackTask)
+#if !UE_BUILD_SHIPPING
+    if (const auto* FoundDebugName = TaskDebugNames.Find(InTask);
+        FoundDebugName != nullptr)
+    {
+        return *FoundDebugName;
+    }
+#endif
 
-    if (NOT IsValid(Task))
+    return GetNameSafe(InTask);
+}
+
+void UBtf_WorldSubsystem::PreloadTaskClasses(const UClass* InClass)
+{
+    auto ClassPaths = TArray<FSoftObjectPath>{};
+    UBtf_TaskPreloadManifest::CollectTaskClasses(InClass, ClassPaths);
+
+    RequestTaskClassPreload(MoveTemp(ClassPaths));
+}
+
+void UBtf_WorldSubsystem::PreloadLevelTaskClasses(const ULevel* InLevel)
+{
+    QUICK_SCOPE_CYCLE_COUNTER(PreloadLevelTaskClasses)
+
+    if (NOT IsValid(InLevel))
     { return; }
 
-    BlueprintTasks.Add(Task);
+    auto ClassPaths = TArray<FSoftObjectPath>{};
+    auto VisitedClasses = TSet<const UClass*>{};
+
+    const auto CollectFromClass = [&](const UClass* InClass)
+    {
+        if (InClass == nullptr)
+        { return; }
+
+        if (auto AlreadyVisited = false;
+            VisitedClasses.Add(InClass, &AlreadyVisited), AlreadyVisited)
+        { return; }
 
-    if (auto* TasksWrapper = ObjectsAndTheirTasks.Find(Task->GetOuter()))
+        UBtf_TaskPreloadManifest::CollectTaskClasses(InClass, ClassPaths);
+    };
+
+    if (const auto* LevelScriptActor = InLevel->GetLevelScriptActor())
     {
-        TasksWrapper->Tasks.AddUnique(Task);
+        CollectFromClass(LevelScriptActor->GetClass());
     }
-    else
+
+    for (const auto& Actor : InLevel->Actors)
     {
-        auto TasksArrayWrapper = FBtf_OutersBlueprintTasksArrayWrapper{};
-        TasksArrayWrapper.Tasks.Add(Task);
-        ObjectsAndTheirTasks.Add(Task->GetOuter(), TasksArrayWrapper);
+        if (IsValid(Actor))
+        {
+            CollectFromClass(Actor->GetClass());
+        }
     }
+
+    RequestTaskClassPreload(MoveTemp(ClassPaths));
 }
 
-void UBtf_WorldSubsystem::UntrackTask(UBtf_TaskForge* Task)
+void UBtf_WorldSubsystem::RequestTaskClassPreload(TArray<FSoftObjectPath> InClassPaths)
 {
-    QUICK_SCOPE_CYCLE_COUNTER(UntrackTask)
+    InClassPaths.RemoveAll([&](const FSoftObjectPath& InClassPath)
+    {
+        auto AlreadyPreloaded = false;
+        PreloadedTaskClasses.Add(InClassPath, &AlreadyPreloaded);
+        return AlreadyPreloaded;
+    });
 
-    if (NOT IsValid(Task))
+    if (InClassPaths.IsEmpty())
     { return; }
 
-    BlueprintTasks.Remove(Task);
+    auto Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+        InClassPaths,
+        FStreamableDelegate::CreateWeakLambda(this, [this, InClassPaths]()
+        {
+            WarmUpTaskClasses(InClassPaths);
+        }),
+        FStreamableManager::AsyncLoadHighPriority);
+
+    if (Handle.IsValid())
+    {
+        TaskClassPreloadHandles.Add(MoveTemp(Handle));
+    }
+}
+
+void UBtf_WorldSubsystem::WarmUpTaskClasses(const TConstArrayView<FSoftObjectPath> InClassPaths)
+{
+    QUICK_SCOPE_CYCLE_COUNTER(WarmUpTaskClasses)
+
+    auto NestedClassPaths = TArray<FSoftObjectPath>{};
 
-    if (auto* TasksWrapper = ObjectsAndTheirTasks.Find(Task->GetOuter()))
+    for (const auto& ClassPath : InClassPaths)
     {
-        TasksWrapper->Tasks.RemoveSingle(Task);
-        if (TasksWrapper->Tasks.IsEmpty())
+        const auto* Class = Cast<UClass>(ClassPath.ResolveObject());
+        if (NOT IsValid(Class) || NOT Class->IsChildOf<UBtf_TaskForge>())
+        { continue; }
+
+        // Builds the class defaults and the script event mask read on every activation
+        if (const auto* Defaults = Class->GetDefaultObject<UBtf_TaskForge>())
         {
-            ObjectsAndTheirTasks.Remove(Task->GetOuter());
+            Defaults->Get_ImplementsScriptEvent(EBtf_TaskScriptEvents::Activate);
         }
+
+        // Task Blueprints spawning tasks of their own
+        UBtf_TaskPreloadManifest::CollectTaskClasses(Class, NestedClassPaths);
     }
+
+    RequestTaskClassPreload(MoveTemp(NestedClassPaths));
 }
 
-TMap<TWeakObjectPtr<UObject>, FBtf_OutersBlueprintTasksArrayWrapper> UBtf_WorldSubsystem::GetTaskTree()
+void UBtf_WorldSubsystem::OnLevelAddedToWorld(ULevel* InLevel, UWorld* InWorld)
 {
-    return ObjectsAndTheirTasks;
+    if (InWorld == GetWorld())
+    {
+        PreloadLevelTaskClasses(InLevel);
+    }
 }
 
 void UBtf_EngineSubsystem::Add(FGuid InTaskNodeGuid, UBtf_TaskForge* InTaskInstance)
@@ -128,4 +1154,140 @@ UBtf_TaskForge* UBtf_EngineSubsystem::FindTaskInstanceWithGuid(FGuid InTaskNodeG
     return nullptr;
 }
 
-// --------------------------------------------------------------------------------------------------------------------
\ No newline at end of file
+UBtf_TaskForge* UBtf_EngineSubsystem::FindNodeTemplate(const UClass* InOuterClass, const FGuid& InNodeGuid)
+{
+    QUICK_SCOPE_CYCLE_COUNTER(FindNodeTemplate)
+
+    if (NOT IsValid(InOuterClass) || NOT InNodeGuid.IsValid())
+    { return nullptr; }
+
+    if (const auto* FoundTemplate = GetOrBuildNodeTemplateIndex(InOuterClass).TemplatesByNodeGuid.Find(InNodeGuid);
+        FoundTemplate != nullptr)
+    {
+        return FoundTemplate->Get();
+    }
+
+    return nullptr;
+}
+
+bool UBtf_EngineSubsystem::IsNodeTemplate(const UBtf_TaskForge* InTask)
+{
+    if (NOT IsValid(InTask))
+    { return false; }
+
+    // Templates are outered to their Blueprint (or its generated class), building that index registers them
+    for (const UObject* Outer = InTask->GetOuter(); Outer != nullptr; Outer = Outer->GetOuter())
+    {
+        if (const auto* Blueprint = Cast<UBlueprint>(Outer))
+        {
+            if (IsValid(Blueprint->GeneratedClass))
+            {
+                GetOrBuildNodeTemplateIndex(Blueprint->GeneratedClass);
+            }
+            break;
+        }
+
+        if (const auto* BPGC = Cast<UBlueprintGeneratedClass>(Outer))
+        {
+            GetOrBuildNodeTemplateIndex(BPGC);
+            break;
+        }
+    }
+
+    return NodeTemplates.Contains(InTask);
+}
+
+void UBtf_EngineSubsystem::InvalidateNodeTemplates()
+{
+    NodeTemplateIndices.Reset();
+    NodeTemplates.Reset();
+}
+
+const FBtf_NodeTemplateIndex& UBtf_EngineSubsystem::GetOrBuildNodeTemplateIndex(const UClass* InOuterClass)
+{
+    if (const auto* FoundIndex = NodeTemplateIndices.Find(InOuterClass);
+        FoundIndex != nullptr)
+    { return *FoundIndex; }
+
+    QUICK_SCOPE_CYCLE_COUNTER(BuildNodeTemplateIndex)
+
+    auto Index = FBtf_NodeTemplateIndex{};
+
+#if !UE_BUILD_TEST
+    // Walk from the most derived class up so that templates of a child Blueprint win, same as the previous linear scan
+    for (const auto* TemplateOwnerClass = InOuterClass; TemplateOwnerClass != nullptr; TemplateOwnerClass = TemplateOwnerClass->GetSuperClass())
+    {
+        const auto* BPGC = Cast<UBlueprintGeneratedClass>(TemplateOwnerClass);
+        if (BPGC == nullptr)
+        { continue; }
+
+        const auto* Blueprint = Cast<UBlueprint>(BPGC->ClassGeneratedBy);
+        if (Blueprint == nullptr || Blueprint->HasAnyFlags(RF_ClassDefaultObject))
+        { continue; }
+
+        for (const auto& Extension : Blueprint->GetExtensions())
+        {
+            auto* Template = Cast<UBtf_TaskForge>(Extension);
+            if (Template == nullptr)
+            { continue; }
+
+            NodeTemplates.Add(Template);
+
+            // Template names are "<TaskClassName><NodeGuid>", the guid being formatted as 32 hex digits
+            const auto TemplateName = Template->GetName();
+            constexpr auto GuidLength = 32;
+            if (TemplateName.Len() < GuidLength)
+            { continue; }
+
+            if (auto NodeGuid = FGuid{};
+                FGuid::ParseExact(TemplateName.Right(GuidLength), EGuidFormats::Digits, NodeGuid))
+            {
+                if (NOT Index.TemplatesByNodeGuid.Contains(NodeGuid))
+                {
+                    Index.TemplatesByNodeGuid.Add(NodeGuid, Template);
+                }
+            }
+        }
+    }
+#endif
+
+    return NodeTemplateIndices.Add(InOuterClass, MoveTemp(Index));
+}
+
+const TArray<const FProperty*>& UBtf_EngineSubsystem::FindSpawnParamProperties(const UClass* InClass, const TConstArrayView<FName> InPropertyNames)
+{
+    const auto Lookup = FBtf_SpawnParamLayoutLookup{InClass, InPropertyNames};
+    const auto Hash = FBtf_SpawnParamLayoutKey::Hash(Lookup.Class, InPropertyNames);
+
+    if (const auto* FoundProperties = SpawnParamLayouts.FindByHash(Hash, Lookup);
+        FoundProperties != nullptr)
+    { return *FoundProperties; }
+
+    auto Properties = TArray<const FProperty*>{};
+    Properties.Reserve(InPropertyNames.Num());
+    for (const auto& PropertyName : InPropertyNames)
+    {
+        Properties.Add(IsValid(InClass) ? FindFProperty<FProperty>(InClass, PropertyName) : nullptr);
+    }
+
+    return SpawnParamLayouts.AddByHash(Hash, FBtf_SpawnParamLayoutKey{Lookup.Class, TArray<FName>(InPropertyNames)}, MoveTemp(Properties));
+}
+
+void UBtf_EngineSubsystem::InvalidateSpawnParamProperties()
+{
+    SpawnParamLayouts.Reset();
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+uint32 FBtf_SpawnParamLayoutKey::Hash(const TObjectKey<UClass>& InClass, const TConstArrayView<FName> InPropertyNames)
+{
+    auto Hash = GetTypeHash(InClass);
+    for (const auto& PropertyName : InPropertyNames)
+    {
+        Hash = HashCombineFast(Hash, GetTypeHash(PropertyName));
+    }
+    return Hash;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
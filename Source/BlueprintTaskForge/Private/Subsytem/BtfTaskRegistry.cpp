@@ -0,0 +1,559 @@
+// Copyright (c) 2025 BlueprintTaskForge Maintainers
+//
+// This file is part of the BlueprintTaskForge Plugin for Unreal Engine.
+//
+// Licensed under the BlueprintTaskForge Open Plugin License v1.0 (BTFPL-1.0).
+// You may obtain a copy of the license at:
+// https://github.com/CommitAndChill/BlueprintTaskForge/blob/main/LICENSE.md
+//
+// SPDX-License-Identifier: BTFPL-1.0
+
+#include "Subsystem/BtfTaskRegistry.h"
+#include "BtfTaskForge.h"
+
+#include "GameFramework/Actor.h"
+
+// --------------------------------------------------------------------------------------------------------------------
+
+namespace
+{
+    // Registries are only touched from the game thread
+    int32 LastRegistrySerial = 0;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+void FBtf_TaskRegistry::Add(UBtf_TaskForge* InTask)
+{
+    if (InTask->RegistrySlot != INDEX_NONE)
+    { return; }
+
+    if (Serial == 0)
+    {
+        Serial = ++LastRegistrySerial;
+    }
+
+    const auto OuterIndex = FindOrAddOuter(InTask->GetOuter());
+    const auto ClassIndex = FindOrAddClass(InTask->GetClass());
+    ++OuterTaskCounts[OuterIndex];
+
+    if (NOT FreeSlots.IsEmpty())
+    {
+        const auto Slot = FreeSlots.Pop(EAllowShrinking::No);
+        Tasks[Slot] = InTask;
+        OuterIndices[Slot] = OuterIndex;
+        ClassIndices[Slot] = ClassIndex;
+        LinkToOuter(Slot, OuterIndex);
+        LinkToClass(Slot, ClassIndex);
+        AddTags(Slot, InTask->TaskTags);
+        InTask->RegistrySlot = Slot;
+        return;
+    }
+
+    const auto Slot = Tasks.Add(InTask);
+    Generations.Add(0);
+    OuterIndices.Add(OuterIndex);
+    ClassIndices.Add(ClassIndex);
+    NextSlotsOfOuter.Add(INDEX_NONE);
+    PrevSlotsOfOuter.Add(INDEX_NONE);
+    NextSlotsOfClass.Add(INDEX_NONE);
+    PrevSlotsOfClass.Add(INDEX_NONE);
+    TagPositionsOfSlot.AddDefaulted();
+    LinkToOuter(Slot, OuterIndex);
+    LinkToClass(Slot, ClassIndex);
+    AddTags(Slot, InTask->TaskTags);
+    InTask->RegistrySlot = Slot;
+}
+
+bool FBtf_TaskRegistry::Remove(UBtf_TaskForge* InTask)
+{
+    const auto Slot = InTask->RegistrySlot;
+    if (NOT Tasks.IsValidIndex(Slot) || Tasks[Slot] != InTask)
+    { return false; }
+
+    // The outer is the one the task was tracked with, even if the task has been moved since
+    const auto OuterIndex = OuterIndices[Slot];
+    const auto ClassIndex = ClassIndices[Slot];
+    UnlinkFromOuter(Slot, OuterIndex);
+    UnlinkFromClass(Slot, ClassIndex);
+    RemoveTags(Slot);
+
+    if (ClassTaskCounts[ClassIndex] == 0)
+    {
+        ReleaseClass(ClassIndex);
+    }
+
+    Tasks[Slot] = nullptr;
+    ++Generations[Slot];
+    OuterIndices[Slot] = INDEX_NONE;
+    ClassIndices[Slot] = INDEX_NONE;
+    FreeSlots.Add(Slot);
+    InTask->RegistrySlot = INDEX_NONE;
+
+    if (--OuterTaskCounts[OuterIndex] > 0)
+    { return false; }
+
+    ReleaseOuter(OuterIndex);
+    return true;
+}
+
+bool FBtf_TaskRegistry::Contains(const UBtf_TaskForge* InTask) const
+{
+    return InTask != nullptr && Tasks.IsValidIndex(InTask->RegistrySlot) && Tasks[InTask->RegistrySlot] == InTask;
+}
+
+FBtf_TaskHandle FBtf_TaskRegistry::Get_Handle(const UBtf_TaskForge* InTask) const
+{
+    if (NOT Contains(InTask))
+    { return FBtf_TaskHandle{}; }
+
+    return FBtf_TaskHandle{Serial, InTask->RegistrySlot, Generations[InTask->RegistrySlot]};
+}
+
+UBtf_TaskForge* FBtf_TaskRegistry::Resolve(const FBtf_TaskHandle& InHandle) const
+{
+    if (Serial == 0 || InHandle.Get_RegistrySerial() != Serial)
+    { return nullptr; }
+
+    const auto Slot = InHandle.Get_SlotIndex();
+    if (NOT Tasks.IsValidIndex(Slot) || Generations[Slot] != InHandle.Get_Generation())
+    { return nullptr; }
+
+    return Tasks[Slot];
+}
+
+void FBtf_TaskRegistry::Reserve(const int32 InNumTasks)
+{
+    const auto NumNewSlots = InNumTasks - FreeSlots.Num();
+    if (NumNewSlots <= 0)
+    { return; }
+
+    Tasks.Reserve(Tasks.Num() + NumNewSlots);
+    Generations.Reserve(Generations.Num() + NumNewSlots);
+    TagPositionsOfSlot.Reserve(TagPositionsOfSlot.Num() + NumNewSlots);
+    OuterIndices.Reserve(OuterIndices.Num() + NumNewSlots);
+    ClassIndices.Reserve(ClassIndices.Num() + NumNewSlots);
+    NextSlotsOfOuter.Reserve(NextSlotsOfOuter.Num() + NumNewSlots);
+    PrevSlotsOfOuter.Reserve(PrevSlotsOfOuter.Num() + NumNewSlots);
+    NextSlotsOfClass.Reserve(NextSlotsOfClass.Num() + NumNewSlots);
+    PrevSlotsOfClass.Reserve(PrevSlotsOfClass.Num() + NumNewSlots);
+}
+
+void FBtf_TaskRegistry::Reset()
+{
+    for (const auto& Task : Tasks)
+    {
+        if (Task != nullptr)
+        {
+            Task->RegistrySlot = INDEX_NONE;
+        }
+    }
+
+    Serial = 0;
+    Tasks.Reset();
+    Generations.Reset();
+    TagPositionsOfSlot.Reset();
+    SlotsByTag.Reset();
+    OuterIndices.Reset();
+    ClassIndices.Reset();
+    NextSlotsOfOuter.Reset();
+    PrevSlotsOfOuter.Reset();
+    NextSlotsOfClass.Reset();
+    PrevSlotsOfClass.Reset();
+    FreeSlots.Reset();
+
+    Outers.Reset();
+    OuterKeys.Reset();
+    OuterTaskCounts.Reset();
+    FirstSlotsOfOuter.Reset();
+    FreeOuters.Reset();
+    OuterIndicesByKey.Reset();
+    OuterActors.Reset();
+    NextOutersOfActor.Reset();
+    PrevOutersOfActor.Reset();
+    FirstOuterOfActor.Reset();
+
+    Classes.Reset();
+    ClassTaskCounts.Reset();
+    FirstSlotsOfClass.Reset();
+    FreeClasses.Reset();
+    ClassIndicesByKey.Reset();
+}
+
+void FBtf_TaskRegistry::ForEachTask(const FTaskVisitor InVisitor) const
+{
+    QUICK_SCOPE_CYCLE_COUNTER(Registry_ForEachTask)
+
+    for (auto Slot = 0; Slot < Tasks.Num(); ++Slot)
+    {
+        if (auto* Task = Tasks[Slot].Get();
+            Task != nullptr && NOT InVisitor(*Task))
+        { return; }
+    }
+}
+
+void FBtf_TaskRegistry::ForEachOuter(const FOuterVisitor InVisitor) const
+{
+    QUICK_SCOPE_CYCLE_COUNTER(Registry_ForEachOuter)
+
+    for (auto OuterIndex = 0; OuterIndex < Outers.Num(); ++OuterIndex)
+    {
+        if (OuterTaskCounts[OuterIndex] == 0)
+        { continue; }
+
+        if (auto* Outer = Outers[OuterIndex].Get();
+            Outer != nullptr && NOT InVisitor(*Outer, OuterTaskCounts[OuterIndex]))
+        { return; }
+    }
+}
+
+void FBtf_TaskRegistry::ForEachOuterOfActor(const AActor* InActor, const FOuterVisitor InVisitor) const
+{
+    const auto* FirstOuterIndex = FirstOuterOfActor.Find(InActor);
+    if (FirstOuterIndex == nullptr)
+    { return; }
+
+    for (auto OuterIndex = *FirstOuterIndex; OuterIndex != INDEX_NONE;)
+    {
+        // Read before visiting, the outer is released once its last task is untracked
+        const auto NextOuterIndex = NextOutersOfActor[OuterIndex];
+
+        if (auto* Outer = Outers[OuterIndex].Get();
+            Outer != nullptr && NOT InVisitor(*Outer, OuterTaskCounts[OuterIndex]))
+        { return; }
+
+        OuterIndex = NextOuterIndex;
+    }
+}
+
+const AActor* FBtf_TaskRegistry::Get_OwningActor(const UObject* InObject)
+{
+    if (const auto* Actor = Cast<AActor>(InObject))
+    { return Actor; }
+
+    return InObject != nullptr ? InObject->GetTypedOuter<AActor>() : nullptr;
+}
+
+void FBtf_TaskRegistry::ForEachTaskOfOuter(const UObject* InOuter, const FTaskVisitor InVisitor) const
+{
+    const auto* OuterIndex = OuterIndicesByKey.Find(InOuter);
+    if (OuterIndex == nullptr)
+    { return; }
+
+    for (auto Slot = FirstSlotsOfOuter[*OuterIndex]; Slot != INDEX_NONE;)
+    {
+        // Read before visiting, the visitor may untrack the task
+        const auto NextSlot = NextSlotsOfOuter[Slot];
+
+        if (auto* Task = Tasks[Slot].Get();
+            Task != nullptr && NOT InVisitor(*Task))
+        { return; }
+
+        Slot = NextSlot;
+    }
+}
+
+void FBtf_TaskRegistry::ForEachTaskOfClass(const UClass* InClass, const bool InIncludeSubclasses, const FTaskVisitor InVisitor) const
+{
+    ForEachClassIndex(InClass, InIncludeSubclasses, [&](const int32 InClassIndex)
+    {
+        for (auto Slot = FirstSlotsOfClass[InClassIndex]; Slot != INDEX_NONE;)
+        {
+            // Read before visiting, the visitor may untrack the task
+            const auto NextSlot = NextSlotsOfClass[Slot];
+
+            if (auto* Task = Tasks[Slot].Get();
+                Task != nullptr && NOT InVisitor(*Task))
+            { return false; }
+
+            Slot = NextSlot;
+        }
+        return true;
+    });
+}
+
+void FBtf_TaskRegistry::ForEachTaskWithTag(const FGameplayTag& InTag, const FTaskVisitor InVisitor) const
+{
+    const auto* TaggedSlots = SlotsByTag.Find(InTag);
+    if (TaggedSlots == nullptr)
+    { return; }
+
+    // Walked backwards: untracking the visited task swaps an already visited slot into its place.
+    // The array is found again every step as tracking a task with a new tag may reallocate the map
+    for (auto Index = TaggedSlots->Num() - 1; Index >= 0; --Index)
+    {
+        TaggedSlots = SlotsByTag.Find(InTag);
+        Index = FMath::Min(Index, TaggedSlots->Num() - 1);
+        if (Index < 0)
+        { return; }
+
+        if (auto* Task = Tasks[(*TaggedSlots)[Index]].Get();
+            Task != nullptr && NOT InVisitor(*Task))
+        { return; }
+    }
+}
+
+int32 FBtf_TaskRegistry::Num_TasksOfOuter(const UObject* InOuter) const
+{
+    const auto* OuterIndex = OuterIndicesByKey.Find(InOuter);
+    return OuterIndex != nullptr ? OuterTaskCounts[*OuterIndex] : 0;
+}
+
+int32 FBtf_TaskRegistry::Num_TasksOfClass(const UClass* InClass, const bool InIncludeSubclasses) const
+{
+    auto NumTasks = 0;
+    ForEachClassIndex(InClass, InIncludeSubclasses, [&](const int32 InClassIndex)
+    {
+        NumTasks += ClassTaskCounts[InClassIndex];
+        return true;
+    });
+    return NumTasks;
+}
+
+void FBtf_TaskRegistry::ForEachClassIndex(const UClass* InClass, const bool InIncludeSubclasses,
+                                          const TFunctionRef<bool(int32 InClassIndex)> InVisitor) const
+{
+    if (InClass == nullptr)
+    { return; }
+
+    if (NOT InIncludeSubclasses)
+    {
+        if (const auto* ClassIndex = ClassIndicesByKey.Find(InClass);
+            ClassIndex != nullptr)
+        {
+            InVisitor(*ClassIndex);
+        }
+        return;
+    }
+
+    // Only the classes with tracked tasks are in the table, a handful compared to the tasks themselves
+    for (auto ClassIndex = 0; ClassIndex < Classes.Num(); ++ClassIndex)
+    {
+        if (ClassTaskCounts[ClassIndex] == 0)
+        { continue; }
+
+        if (const auto* Class = Classes[ClassIndex].ResolveObjectPtr();
+            Class != nullptr && Class->IsChildOf(InClass) && NOT InVisitor(ClassIndex))
+        { return; }
+    }
+}
+
+int32 FBtf_TaskRegistry::FindOrAddOuter(UObject* InOuter)
+{
+    if (const auto* FoundIndex = OuterIndicesByKey.Find(InOuter);
+        FoundIndex != nullptr)
+    { return *FoundIndex; }
+
+    auto OuterIndex = INDEX_NONE;
+    if (NOT FreeOuters.IsEmpty())
+    {
+        OuterIndex = FreeOuters.Pop(EAllowShrinking::No);
+        Outers[OuterIndex] = InOuter;
+        OuterKeys[OuterIndex] = InOuter;
+        OuterTaskCounts[OuterIndex] = 0;
+        FirstSlotsOfOuter[OuterIndex] = INDEX_NONE;
+    }
+    else
+    {
+        OuterIndex = Outers.Add(InOuter);
+        OuterKeys.Add(InOuter);
+        OuterTaskCounts.Add(0);
+        FirstSlotsOfOuter.Add(INDEX_NONE);
+        OuterActors.AddDefaulted();
+        NextOutersOfActor.Add(INDEX_NONE);
+        PrevOutersOfActor.Add(INDEX_NONE);
+    }
+
+    OuterIndicesByKey.Add(InOuter, OuterIndex);
+    LinkToActor(OuterIndex, Get_OwningActor(InOuter));
+    return OuterIndex;
+}
+
+int32 FBtf_TaskRegistry::FindOrAddClass(const UClass* InClass)
+{
+    if (const auto* FoundIndex = ClassIndicesByKey.Find(InClass);
+        FoundIndex != nullptr)
+    { return *FoundIndex; }
+
+    auto ClassIndex = INDEX_NONE;
+    if (NOT FreeClasses.IsEmpty())
+    {
+        ClassIndex = FreeClasses.Pop(EAllowShrinking::No);
+        Classes[ClassIndex] = InClass;
+        ClassTaskCounts[ClassIndex] = 0;
+        FirstSlotsOfClass[ClassIndex] = INDEX_NONE;
+    }
+    else
+    {
+        ClassIndex = Classes.Add(InClass);
+        ClassTaskCounts.Add(0);
+        FirstSlotsOfClass.Add(INDEX_NONE);
+    }
+
+    ClassIndicesByKey.Add(InClass, ClassIndex);
+    return ClassIndex;
+}
+
+void FBtf_TaskRegistry::LinkToOuter(const int32 InSlot, const int32 InOuterIndex)
+{
+    const auto FirstSlot = FirstSlotsOfOuter[InOuterIndex];
+
+    NextSlotsOfOuter[InSlot] = FirstSlot;
+    PrevSlotsOfOuter[InSlot] = INDEX_NONE;
+    if (FirstSlot != INDEX_NONE)
+    {
+        PrevSlotsOfOuter[FirstSlot] = InSlot;
+    }
+    FirstSlotsOfOuter[InOuterIndex] = InSlot;
+}
+
+void FBtf_TaskRegistry::UnlinkFromOuter(const int32 InSlot, const int32 InOuterIndex)
+{
+    const auto NextSlot = NextSlotsOfOuter[InSlot];
+    const auto PrevSlot = PrevSlotsOfOuter[InSlot];
+
+    if (PrevSlot != INDEX_NONE)
+    { NextSlotsOfOuter[PrevSlot] = NextSlot; }
+    else
+    { FirstSlotsOfOuter[InOuterIndex] = NextSlot; }
+
+    if (NextSlot != INDEX_NONE)
+    { PrevSlotsOfOuter[NextSlot] = PrevSlot; }
+
+    NextSlotsOfOuter[InSlot] = INDEX_NONE;
+    PrevSlotsOfOuter[InSlot] = INDEX_NONE;
+}
+
+void FBtf_TaskRegistry::LinkToClass(const int32 InSlot, const int32 InClassIndex)
+{
+    const auto FirstSlot = FirstSlotsOfClass[InClassIndex];
+
+    NextSlotsOfClass[InSlot] = FirstSlot;
+    PrevSlotsOfClass[InSlot] = INDEX_NONE;
+    if (FirstSlot != INDEX_NONE)
+    {
+        PrevSlotsOfClass[FirstSlot] = InSlot;
+    }
+    FirstSlotsOfClass[InClassIndex] = InSlot;
+    ++ClassTaskCounts[InClassIndex];
+}
+
+void FBtf_TaskRegistry::UnlinkFromClass(const int32 InSlot, const int32 InClassIndex)
+{
+    const auto NextSlot = NextSlotsOfClass[InSlot];
+    const auto PrevSlot = PrevSlotsOfClass[InSlot];
+
+    if (PrevSlot != INDEX_NONE)
+    { NextSlotsOfClass[PrevSlot] = NextSlot; }
+    else
+    { FirstSlotsOfClass[InClassIndex] = NextSlot; }
+
+    if (NextSlot != INDEX_NONE)
+    { PrevSlotsOfClass[NextSlot] = PrevSlot; }
+
+    NextSlotsOfClass[InSlot] = INDEX_NONE;
+    PrevSlotsOfClass[InSlot] = INDEX_NONE;
+    --ClassTaskCounts[InClassIndex];
+}
+
+void FBtf_TaskRegistry::AddTags(const int32 InSlot, const FGameplayTagContainer& InTags)
+{
+    if (InTags.IsEmpty())
+    { return; }
+
+    // Parents are indexed too so that querying a parent tag finds the tasks tagged with any of its children
+    const auto AllTags = InTags.GetGameplayTagParents();
+
+    auto& TagPositions = TagPositionsOfSlot[InSlot];
+    TagPositions.Reserve(AllTags.Num());
+
+    for (const auto& Tag : AllTags)
+    {
+        auto& TaggedSlots = SlotsByTag.FindOrAdd(Tag);
+        TagPositions.Emplace(Tag, TaggedSlots.Add(InSlot));
+    }
+}
+
+void FBtf_TaskRegistry::RemoveTags(const int32 InSlot)
+{
+    auto& TagPositions = TagPositionsOfSlot[InSlot];
+
+    for (const auto& [Tag, Position] : TagPositions)
+    {
+        auto& TaggedSlots = SlotsByTag.FindChecked(Tag);
+        TaggedSlots.RemoveAtSwap(Position, 1, EAllowShrinking::No);
+
+        if (NOT TaggedSlots.IsValidIndex(Position))
+        { continue; }
+
+        // The last slot of the array took our place, point its entry for this tag at it
+        const auto MovedSlot = TaggedSlots[Position];
+        for (auto& [MovedTag, MovedPosition] : TagPositionsOfSlot[MovedSlot])
+        {
+            if (MovedTag == Tag)
+            {
+                MovedPosition = Position;
+                break;
+            }
+        }
+    }
+
+    TagPositions.Reset();
+}
+
+void FBtf_TaskRegistry::LinkToActor(const int32 InOuterIndex, const AActor* InActor)
+{
+    auto& FirstOuterIndex = FirstOuterOfActor.FindOrAdd(InActor, INDEX_NONE);
+
+    OuterActors[InOuterIndex] = InActor;
+    NextOutersOfActor[InOuterIndex] = FirstOuterIndex;
+    PrevOutersOfActor[InOuterIndex] = INDEX_NONE;
+
+    if (FirstOuterIndex != INDEX_NONE)
+    { PrevOutersOfActor[FirstOuterIndex] = InOuterIndex; }
+
+    FirstOuterIndex = InOuterIndex;
+}
+
+void FBtf_TaskRegistry::UnlinkFromActor(const int32 InOuterIndex)
+{
+    const auto NextOuterIndex = NextOutersOfActor[InOuterIndex];
+    const auto PrevOuterIndex = PrevOutersOfActor[InOuterIndex];
+
+    if (PrevOuterIndex != INDEX_NONE)
+    { NextOutersOfActor[PrevOuterIndex] = NextOuterIndex; }
+    else if (NextOuterIndex != INDEX_NONE)
+    { FirstOuterOfActor.FindChecked(OuterActors[InOuterIndex]) = NextOuterIndex; }
+    else
+    { FirstOuterOfActor.Remove(OuterActors[InOuterIndex]); }
+
+    if (NextOuterIndex != INDEX_NONE)
+    { PrevOutersOfActor[NextOuterIndex] = PrevOuterIndex; }
+
+    OuterActors[InOuterIndex] = TObjectKey<AActor>{};
+    NextOutersOfActor[InOuterIndex] = INDEX_NONE;
+    PrevOutersOfActor[InOuterIndex] = INDEX_NONE;
+}
+
+void FBtf_TaskRegistry::ReleaseOuter(const int32 InOuterIndex)
+{
+    // Removed through the stored key, the outer itself may already be gone
+    OuterIndicesByKey.Remove(OuterKeys[InOuterIndex]);
+    UnlinkFromActor(InOuterIndex);
+
+    Outers[InOuterIndex].Reset();
+    OuterKeys[InOuterIndex] = TObjectKey<UObject>{};
+    FreeOuters.Add(InOuterIndex);
+}
+
+void FBtf_TaskRegistry::ReleaseClass(const int32 InClassIndex)
+{
+    // Removed through the stored key, the class may have been recompiled or unloaded meanwhile
+    ClassIndicesByKey.Remove(Classes[InClassIndex]);
+
+    Classes[InClassIndex] = TObjectKey<UClass>{};
+    FirstSlotsOfClass[InClassIndex] = INDEX_NONE;
+    FreeClasses.Add(InClassIndex);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
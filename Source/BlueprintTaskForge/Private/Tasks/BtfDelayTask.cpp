@@ -0,0 +1,66 @@
+// Copyright (c) 2025 BlueprintTaskForge Maintainers
+//
+// This file is part of the BlueprintTaskForge Plugin for Unreal Engine.
+//
+// Licensed under the BlueprintTaskForge Open Plugin License v1.0 (BTFPL-1.0).
+// You may obtain a copy of the license at:
+// https://github.com/CommitAndChill/BlueprintTaskForge/blob/main/LICENSE.md
+//
+// SPDX-License-Identifier: BTFPL-1.0
+
+#include "Tasks/BtfDelayTask.h"
+
+#include "BftMacros.h"
+#include "BtfSpawnTask.h"
+
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+// --------------------------------------------------------------------------------------------------------------------
+
+UBtf_DelayTask* UBtf_DelayTask::Start(UObject* InOuter, const float InDuration)
+{
+    return Btf::SpawnTask<UBtf_DelayTask>(InOuter, Btf::Param(&UBtf_DelayTask::Duration, InDuration));
+}
+
+void UBtf_DelayTask::Activate_Internal()
+{
+    Super::Activate_Internal();
+
+    if (NOT Get_IsActive())
+    { return; }
+
+    const auto World = GetWorld();
+    if (NOT IsValid(World) || Duration <= 0.0f)
+    {
+        OnDelayElapsed();
+        return;
+    }
+
+    World->GetTimerManager().SetTimer(DelayTimerHandle, FTimerDelegate::CreateUObject(this, &UBtf_DelayTask::OnDelayElapsed), Duration, false);
+}
+
+void UBtf_DelayTask::Deactivate_Internal()
+{
+    if (const auto World = GetWorld();
+        IsValid(World))
+    {
+        World->GetTimerManager().ClearTimer(DelayTimerHandle);
+    }
+    DelayTimerHandle.Invalidate();
+
+    Super::Deactivate_Internal();
+}
+
+void UBtf_DelayTask::OnDelayElapsed()
+{
+    DelayTimerHandle.Invalidate();
+
+    OnCompleted.Broadcast();
+    if (Get_IsActive())
+    {
+        Deactivate();
+    }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
@@ -45,6 +45,18 @@ public:
     UFUNCTION(BlueprintCallable, BlueprintInternalUseOnly)
     static UObject* ExtendConstructObject(UObject* Outer, TSubclassOf<UObject> Class);
 
+    /* Assigns each value passed after @PropertyNames to the property of @Object with the matching name.
+     * Used by the node to apply all connected spawn params with a single call, the properties are
+     * resolved once per class and the values are written straight into @Object. */
+    UFUNCTION(BlueprintCallable, CustomThunk, BlueprintInternalUseOnly, meta = (Variadic))
+    static void ApplySpawnParams(UObject* Object, const TArray<FName>& PropertyNames);
+    DECLARE_FUNCTION(execApplySpawnParams);
+
+    /* Binds @FunctionName of @Listener to the multicast delegate @DelegateName of @Object.
+     * Used by nodes that can not reference the class declaring the delegate, the signatures are only checked in development builds. */
+    UFUNCTION(BlueprintCallable, BlueprintInternalUseOnly)
+    static void BindDelegateByName(UObject* Object, FName DelegateName, UObject* Listener, FName FunctionName);
+
     static bool GetNumericSuffix(const FString& InStr, int32& Suffix);
     static bool LessSuffix(const FName& A, const FString& AStr, const FName& B, const FString& BStr);
 
@@ -0,0 +1,97 @@
+// Copyright (c) 2025 BlueprintTaskForge Maintainers
+//
+// This file is part of the BlueprintTaskForge Plugin for Unreal Engine.
+//
+// Licensed under the BlueprintTaskForge Open Plugin License v1.0 (BTFPL-1.0).
+// You may obtain a copy of the license at:
+// https://github.com/CommitAndChill/BlueprintTaskForge/blob/main/LICENSE.md
+//
+// SPDX-License-Identifier: BTFPL-1.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BtfTaskForge.h"
+
+#include <type_traits>
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/* Base for tasks written entirely in C++, to be inherited next to UBtf_TaskForge:
+ *
+ *     UCLASS()
+ *     class UMyTask : public UBtf_TaskForge, public TBtf_NativeTask<UMyTask>
+ *     {
+ *         GENERATED_BODY()
+ *         friend class TBtf_NativeTask<UMyTask>;
+ *
+ *         void NativeActivate();
+ *         void NativeDeactivate();
+ *         void NativeTick(float DeltaTime); // Optional, ticked by the world subsystem while active if declared
+ *     };
+ *
+ * The lifecycle events are called directly on the derived class instead of going through the Blueprint VM.
+ * Activate_BP and Deactivate_BP are still called, but only for Blueprint subclasses that implement them.
+ * The task keeps working with the existing nodes, nothing about its reflection data changes. */
+template <typename TDerived>
+class TBtf_NativeTask
+{
+public:
+    /* Triggers the custom output pin @InPinName of the node with @InPayload as its data. */
+    template <typename TPayload>
+    void TriggerPin(const FName InPinName, const TPayload& InPayload)
+    {
+        static_assert(std::is_base_of_v<FCustomOutputPinData, TPayload>, "Custom pin payloads derive from FCustomOutputPinData");
+        Get_Task().TriggerCustomOutputPin(InPinName, TInstancedStruct<FCustomOutputPinData>::Make(InPayload));
+    }
+
+    void TriggerPin(const FName InPinName)
+    {
+        Get_Task().TriggerCustomOutputPin(InPinName, TInstancedStruct<FCustomOutputPinData>{});
+    }
+
+protected:
+    TBtf_NativeTask()
+    {
+        static_assert(std::is_base_of_v<UBtf_TaskForge, TDerived>, "Native tasks derive from UBtf_TaskForge");
+        Get_Task().NativeDispatch = &Dispatch;
+    }
+
+    // Hidden by the derived class
+    void NativeActivate() {}
+    void NativeDeactivate() {}
+
+private:
+    template <typename T, typename = void>
+    struct THasNativeTick : std::false_type {};
+
+    template <typename T>
+    struct THasNativeTick<T, std::void_t<decltype(std::declval<T&>().NativeTick(0.0f))>> : std::true_type {};
+
+    auto Get_Task() -> UBtf_TaskForge& { return *static_cast<TDerived*>(this); }
+
+    static void Activate(UBtf_TaskForge& InTask)
+    {
+        static_cast<TDerived&>(InTask).NativeActivate();
+    }
+
+    static void Deactivate(UBtf_TaskForge& InTask)
+    {
+        static_cast<TDerived&>(InTask).NativeDeactivate();
+    }
+
+    static void Tick(UBtf_TaskForge& InTask, const float InDeltaTime)
+    {
+        if constexpr (THasNativeTick<TDerived>::value)
+        {
+            static_cast<TDerived&>(InTask).NativeTick(InDeltaTime);
+        }
+    }
+
+    static constexpr FBtf_NativeTaskDispatch Dispatch{
+        &TBtf_NativeTask::Activate,
+        &TBtf_NativeTask::Deactivate,
+        THasNativeTick<TDerived>::value ? &TBtf_NativeTask::Tick : nullptr};
+};
+
+// --------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,106 @@
+// Copyright (c) 2025 BlueprintTaskForge Maintainers
+//
+// This file is part of the BlueprintTaskForge Plugin for Unreal Engine.
+//
+// Licensed under the BlueprintTaskForge Open Plugin License v1.0 (BTFPL-1.0).
+// You may obtain a copy of the license at:
+// https://github.com/CommitAndChill/BlueprintTaskForge/blob/main/LICENSE.md
+//
+// SPDX-License-Identifier: BTFPL-1.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BtfTaskForge.h"
+#include "Subsystem/BtfSubsystem.h"
+#include "Engine/World.h"
+
+#include <type_traits>
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/* Native counterpart of the task node:
+ *
+ *     auto* Task = Btf::SpawnTask<UMyTask>(this,
+ *         Btf::Param(&UMyTask::Duration, 2.0f),
+ *         Btf::Param(&UMyTask::Target, TargetActor));
+ *
+ * Spawn params are member pointers, a misspelled name or a value of the wrong type fails to compile,
+ * and values are assigned directly instead of going through the task's reflection data.
+ * @SpawnTaskOfClass does the same for Blueprint classes derived from a native task. */
+namespace Btf
+{
+    template <typename TOwner, typename TMember>
+    struct TSpawnParam
+    {
+        using FOwner = TOwner;
+
+        TMember TOwner::* Member;
+        TMember Value;
+
+        void ApplyTo(TOwner& InTask) const { InTask.*Member = Value; }
+    };
+
+    template <typename TOwner, typename TMember, typename TValue>
+    auto Param(TMember TOwner::* InMember, TValue&& InValue) -> TSpawnParam<TOwner, TMember>
+    {
+        static_assert(std::is_base_of_v<UBtf_TaskForge, TOwner>, "Spawn params must be members of a task");
+        static_assert(std::is_constructible_v<TMember, TValue&&>, "The value can not be assigned to this spawn param");
+
+        return TSpawnParam<TOwner, TMember>{InMember, TMember(Forward<TValue>(InValue))};
+    }
+
+    namespace Private
+    {
+        template <typename TTask, typename TParam>
+        constexpr bool IsSpawnParamOf = std::is_base_of_v<typename TParam::FOwner, TTask>;
+
+        template <typename TTask, typename... TParams>
+        auto CreateTask(UObject* InOuter, UClass* InClass, const TParams&... InParams) -> TTask*
+        {
+            static_assert(std::is_base_of_v<UBtf_TaskForge, TTask>, "Only tasks can be spawned");
+            static_assert((IsSpawnParamOf<TTask, TParams> && ...), "Spawn param belongs to a class the task does not derive from");
+
+            if (NOT IsValid(InOuter) || NOT IsValid(InClass) || InClass->HasAnyClassFlags(CLASS_Abstract))
+            { return nullptr; }
+
+            const auto World = InOuter->GetWorld();
+            auto* WorldSubsystem = IsValid(World) ? World->GetSubsystem<UBtf_WorldSubsystem>() : nullptr;
+
+            auto* Task = CastChecked<TTask>(UBtf_TaskForge::CreateTask(InOuter, InClass, nullptr, WorldSubsystem), ECastCheckedType::NullAllowed);
+            if (Task == nullptr || Task->IsRunningOnClassDefaults())
+            { return Task; }
+
+            (InParams.ApplyTo(*Task), ...);
+            return Task;
+        }
+    }
+
+    /* Spawns a task of @InClass with @InParams applied, without activating it.
+     * Delegates of the task can be bound before calling Activate. */
+    template <typename TTask, typename... TParams>
+    auto SpawnTaskDeferred(UObject* InOuter, TSubclassOf<TTask> InClass, const TParams&... InParams) -> TTask*
+    {
+        return Private::CreateTask<TTask>(InOuter, InClass, InParams...);
+    }
+
+    /* Spawns a task of @InClass with @InParams applied, then activates it (which registers it with the world subsystem). */
+    template <typename TTask, typename... TParams>
+    auto SpawnTaskOfClass(UObject* InOuter, TSubclassOf<TTask> InClass, const TParams&... InParams) -> TTask*
+    {
+        auto* Task = Private::CreateTask<TTask>(InOuter, InClass, InParams...);
+        if (Task != nullptr)
+        {
+            Task->Activate();
+        }
+        return Task;
+    }
+
+    template <typename TTask, typename... TParams>
+    auto SpawnTask(UObject* InOuter, const TParams&... InParams) -> TTask*
+    {
+        return SpawnTaskOfClass<TTask>(InOuter, TTask::StaticClass(), InParams...);
+    }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
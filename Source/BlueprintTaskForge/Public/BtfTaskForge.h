@@ -12,7 +12,11 @@
 
 #include "CoreMinimal.h"
 #include "Templates/SubclassOf.h"
+#include "UObject/SoftObjectPtr.h"
+#include "Engine/LatentActionManager.h"
 #include "BtfNameSelect.h"
+#include "BtfTaskHandle.h"
+#include "GameplayTagContainer.h"
 #include "BftMacros.h"
 
 #include "Blueprint/BlueprintExtension.h"
@@ -53,6 +57,60 @@ struct FCustomOutputPinData
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FCustomPinDelegate, FName, PinName, TInstancedStruct<FCustomOutputPinData>, Data);
 
+UENUM()
+enum class EBtf_TaskInstancingPolicy : uint8
+{
+    /* The task runs on its class defaults, nothing is allocated or tracked.
+     * Only suited for stateless tasks, the node can not expose delegates, exec functions or spawn params. */
+    NonInstanced,
+
+    /* A single instance is kept per outer and reused (reset from its defaults) by every execution.
+     * Executing the node again while the instance is active deactivates it first. */
+    InstancedPerOuter,
+
+    /* Every execution of the node creates a new task. */
+    InstancedPerExecution
+};
+
+UENUM()
+enum class EBtf_TaskReentrancyPolicy : uint8
+{
+    /* Every execution of the node spawns a task, whether or not the previous one is still active. */
+    Parallel,
+
+    /* The task still active from a previous execution of the node on the same outer is deactivated first. */
+    RestartExisting,
+
+    /* Executing the node while its previous task on the same outer is active does nothing. */
+    IgnoreWhileRunning,
+
+    /* The task is spawned but only activated once the tasks spawned before it on the same outer deactivated. */
+    Queue
+};
+
+/* Events of a task that a Blueprint class may implement, cached per class to skip the Blueprint VM for the others. */
+enum class EBtf_TaskScriptEvents : uint8
+{
+    None                  = 0,
+    Activate              = 1 << 0,
+    Deactivate            = 1 << 1,
+    NodeTitleColor        = 1 << 2,
+    NodeDescription       = 1 << 3,
+    StatusString          = 1 << 4,
+    StatusBackgroundColor = 1 << 5
+};
+ENUM_CLASS_FLAGS(EBtf_TaskScriptEvents);
+
+/* Lifecycle entry points of a task implemented in C++, see TBtf_NativeTask (BtfNativeTask.h). */
+struct FBtf_NativeTaskDispatch
+{
+    void (*Activate)(UBtf_TaskForge& InTask) = nullptr;
+    void (*Deactivate)(UBtf_TaskForge& InTask) = nullptr;
+
+    // Only set for tasks that tick, called by the world subsystem while they are active
+    void (*Tick)(UBtf_TaskForge& InTask, float InDeltaTime) = nullptr;
+};
+
 // --------------------------------------------------------------------------------------------------------------------
 
 UCLASS(Abstract, Blueprintable, BlueprintType, EditInlineNew)
@@ -73,15 +131,63 @@ public:
              BlueprintInternalUseOnly = "TRUE",
              DeterminesOutputType = "Class",
              Keywords = "BP Blueprint Task Forge"))
-    static UBtf_TaskForge* BlueprintTaskForge(UObject* Outer, TSubclassOf<UBtf_TaskForge> Class, FString NodeGuidStr);
-
-    static UBtf_TaskForge* GetTaskByNodeGUID(UObject* Outer, FString NodeGUID);
-
-    /* Gets all objects that have @Object assigned as their outer
-     * and recursively deactivates all tasks it finds.
-     * This includes nested objects, so for example; if @Object is
+    static UBtf_TaskForge* BlueprintTaskForge(
+        UObject* Outer,
+        TSubclassOf<UBtf_TaskForge> Class,
+        FGuid NodeGuid,
+        UBtf_TaskForge* Template,
+        EBtf_TaskReentrancyPolicy ReentrancyPolicy);
+
+    /* Spawns @CountPerOuter tasks of @Class for each of @Outers, using @SharedParams (if set) as the template
+     * of every task. The template, the subsystems and the registry space are resolved once for the whole batch
+     * and, if @ActivateTasks is set, the batch is tracked and activated in a single pass.
+     * Classes instanced per outer get a single task per outer, whatever @CountPerOuter and however often
+     * the outer is listed. */
+    UFUNCTION(BlueprintCallable, Category = "BlueprintTaskForge", meta = (DeterminesOutputType = "Class", AdvancedDisplay = "SharedParams"))
+    static TArray<UBtf_TaskForge*> SpawnTaskBatch(
+        const TArray<UObject*>& Outers,
+        TSubclassOf<UBtf_TaskForge> Class,
+        int32 CountPerOuter = 1,
+        UBtf_TaskForge* SharedParams = nullptr,
+        bool ActivateTasks = true);
+
+    /* Task of @Class holding the spawn params of a batch node, see @SpawnTaskBatch. It is created from @Template
+     * under @Owner on the first execution of the node and reused by the following ones, its template delta
+     * always covers the @SpawnParamNames the node writes before every batch. */
+    UFUNCTION(BlueprintCallable, BlueprintInternalUseOnly, meta = (DeterminesOutputType = "Class"))
+    static UBtf_TaskForge* MakeTaskBatchParams(
+        UObject* Owner,
+        FName ParamsName,
+        TSubclassOf<UBtf_TaskForge> Class,
+        UBtf_TaskForge* Template,
+        const TArray<FName>& SpawnParamNames);
+
+    /* Streams @Class in, the latent output fires once it is loaded (or failed to load).
+     * Used by nodes that only reference their task class softly. */
+    UFUNCTION(BlueprintCallable, BlueprintInternalUseOnly, meta = (Latent, LatentInfo = "LatentInfo", WorldContext = "WorldContextObject"))
+    static void LoadTaskClass(UObject* WorldContextObject, TSoftClassPtr<UBtf_TaskForge> Class, FLatentActionInfo LatentInfo);
+
+    UFUNCTION(BlueprintPure, BlueprintInternalUseOnly)
+    static bool IsTaskClassLoaded(TSoftClassPtr<UBtf_TaskForge> Class);
+
+    /* The loaded class of @Class, null if it is not loaded. */
+    UFUNCTION(BlueprintPure, BlueprintInternalUseOnly)
+    static TSubclassOf<UBtf_TaskForge> ResolveTaskClass(TSoftClassPtr<UBtf_TaskForge> Class);
+
+    /* Constructs (or takes from the pool) a task without activating it. Shared by all the spawn paths,
+     * @WorldSubsystem may be null if @Outer is not part of a world. */
+    static UBtf_TaskForge* CreateTask(UObject* Outer, UClass* Class, UBtf_TaskForge* Template, class UBtf_WorldSubsystem* WorldSubsystem);
+
+    /* Looks up the instance template of a node through the Blueprint's extensions.
+     * Compiled nodes receive their template directly, this is only needed for editor tooling. */
+    static UBtf_TaskForge* GetTaskByNodeGUID(UObject* Outer, const FGuid& NodeGuid);
+
+    /* Deactivates all tasks that have @Object assigned as their outer,
+     * or an outer nested in @Object. So for example; if @Object is
      * an actor and its actor components have a task active and the
-     * component is its outer, this will also deactivate those tasks. */
+     * component is its outer, this will also deactivate those tasks.
+     * Only the outers with tasks are looked at, not every subobject of @Object.
+     * An @Object that is not part of an actor (such as a level) also covers the actors nested in it. */
     UFUNCTION(Category = "BlueprintTaskForge", BlueprintCallable, meta = (DefaultToSelf = "Object"))
     static void DeactivateAllTasksRelatedToObject(UObject* Object);
 
@@ -104,6 +210,15 @@ public:
     UFUNCTION(Category = "BlueprintTaskForge", BlueprintCallable, BlueprintPure)
     bool IsExtension() const;
 
+    /* Handle to this task while it is active, unset otherwise.
+     * Cheaper to hold and resolve than an object reference, and it never resolves to a reused pooled task. */
+    UFUNCTION(Category = "BlueprintTaskForge", BlueprintCallable, BlueprintPure)
+    FBtf_TaskHandle Get_TaskHandle() const;
+
+    /* The task @Handle was issued for, null once that task has been deactivated. */
+    UFUNCTION(Category = "BlueprintTaskForge", BlueprintCallable, BlueprintPure, meta = (WorldContext = "WorldContextObject"))
+    static UBtf_TaskForge* ResolveTaskHandle(UObject* WorldContextObject, FBtf_TaskHandle Handle);
+
     // Blueprint Native Events
     UFUNCTION(BlueprintNativeEvent, Category = "BlueprintTaskForge")
     TArray<FCustomOutputPin> Get_CustomOutputPins() const;
@@ -123,17 +238,70 @@ public:
     UFUNCTION(BlueprintNativeEvent, Category = "BlueprintTaskForge", meta = (DisplayName = "Get Status Background Color"))
     bool Get_StatusBackgroundColor(FLinearColor& OutColor) const;
 
+    /* Same as the events above, but only going through the Blueprint VM if the class implements them. */
+    bool Query_NodeTitleColor(FLinearColor& OutColor);
+    FString Query_NodeDescription() const;
+    FString Query_StatusString() const;
+    bool Query_StatusBackgroundColor(FLinearColor& OutColor) const;
+
+    bool Get_ImplementsScriptEvent(EBtf_TaskScriptEvents InEvent) const;
+
+    /* Drops the cached script events of every task class, they are rebuilt on first use. */
+    static void InvalidateScriptEvents();
+
     // Virtual Functions
     virtual UWorld* GetWorld() const override;
+    // The readable name of the world subsystem in DebugNames mode
+    virtual FString GetDetailedInfoInternal() const override;
     virtual void OnDestroy();
     virtual void Serialize(FArchive& Ar) override;
     virtual void TrackTaskForAutomaticDeactivation(UBtf_TaskForge* Task);
     virtual void UntrackTaskForAutomaticDeactivation(UBtf_TaskForge* Task);
 
+    /* Called right before a pooled task is handed out again.
+     * The default implementation restores every property from @Archetype,
+     * which is either the class defaults or the node's instance template. */
+    virtual void ResetForReuse(const UBtf_TaskForge* Archetype);
+
+    /* Called once a deactivated task is returned to its pool instead of being destroyed.
+     * Anything that should not outlive the current use of the task must be released here. */
+    virtual void OnReturnedToPool();
+
+    bool CanBePooled() const;
+    bool IsRunningOnClassDefaults() const;
+
+    auto Get_ReentrancyNodeGuid() const -> const FGuid& { return ReentrancyNodeGuid; }
+    auto Get_ReentrancyPolicy() const -> EBtf_TaskReentrancyPolicy { return ReentrancyPolicy; }
+
+    /* Whether tasks spawned from this instance template can be constructed from the class defaults
+     * with only the properties that differ applied on top. This is not the case if any of them
+     * holds instanced subobjects, those tasks are constructed from the template as a whole. */
+    bool CanApplyTemplateDelta() const;
+    void ApplyTemplateDelta(UBtf_TaskForge* Task) const;
+
     // Properties
     UPROPERTY(BlueprintAssignable)
     FCustomPinDelegate OnCustomPinTriggered;
 
+    /* If task pooling is enabled in the runtime settings, deactivated tasks of this class
+     * are reset and reused instead of being marked as garbage.
+     * Do not hold on to a task after it has been deactivated when this is enabled. */
+    UPROPERTY(EditDefaultsOnly, Category = "Performance")
+    bool AllowPooling = false;
+
+    /* Groups the task belongs to, for the tag queries of the world subsystem such as DeactivateTasksWithTag.
+     * Set in the class defaults or as a spawn param, the tags are read when the task activates. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Task")
+    FGameplayTagContainer TaskTags;
+
+    /* When the world ends or the streaming level of the task's outer is unloaded, active tasks are released
+     * in bulk without going through their regular deactivation. Enable to still run the Deactivate event. */
+    UPROPERTY(EditDefaultsOnly, Category = "Performance")
+    bool DeactivateOnTeardown = false;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Performance")
+    EBtf_TaskInstancingPolicy InstancingPolicy = EBtf_TaskInstancingPolicy::InstancedPerExecution;
+
 #if WITH_EDITORONLY_DATA
     UPROPERTY(Category = "Decorator", EditDefaultsOnly)
     TSubclassOf<UBtf_NodeDecorator> Decorator = nullptr;
@@ -188,7 +356,7 @@ protected:
     UFUNCTION(BlueprintImplementableEvent, Category = "BlueprintTaskForge", meta = (DisplayName = "Deactivate"))
     void Deactivate_BP();
 
-    UFUNCTION()
+    // Called by the world subsystem once the actor owning the task's outer is destroyed
     void OnActorOuterDestroyed(AActor* Actor);
 
     // Virtual Protected Functions
@@ -196,11 +364,12 @@ protected:
     virtual void Deactivate_Internal();
     virtual void SetupAutomaticCleanup();
 
-#if WITH_EDITOR
 public:
-    void RefreshCollected();
     auto Get_IsActive() const -> bool;
 
+#if WITH_EDITOR
+    void RefreshCollected();
+
 protected:
     virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
     static void CollectSpawnParam(const UClass* InClass, TSet<FName>& Out);
@@ -210,13 +379,86 @@ protected:
 #endif
 
 private:
+    template <typename TDerived>
+    friend class TBtf_NativeTask;
+    friend struct FBtf_TaskRegistry;
+    friend class UBtf_WorldSubsystem;
+
+    // Deactivates the task once its actor outer is destroyed, right away or from the world subsystem's deferred queue
+    void DeactivateForDestroyedOuter();
+
+    // Destroys the task while its world or level is torn down, the subsystem has already untracked it
+    void ReleaseForTeardown();
+
+    // Runs the native implementation of the event (if any), and the Blueprint one only if the class implements it
+    void Dispatch_Activate();
+    void Dispatch_Deactivate();
+
+    // Takes the task out of the native tick list of its world subsystem
+    void StopNativeTick();
+
     UPROPERTY(Transient)
     bool IsBeingDestroyed = false;
 
+    // Waiting in the deferred deactivation queue of the world subsystem
+    UPROPERTY(Transient)
+    bool IsPendingDeactivation = false;
+
+    // Set while DeactivateForDestroyedOuter runs, a deferred task's actor is already marked as garbage by then
+    bool IsDeactivatingForDestroyedOuter = false;
+
     UPROPERTY(Transient)
     bool IsActive = false;
 
-    TArray<TWeakObjectPtr<UBtf_TaskForge>> TasksToDeactivateOnDeactivate;
+    // Tasks outered to this one are deactivated along with it, linked through the tasks themselves
+    void DetachChildTasks();
+
+    UPROPERTY(Transient)
+    TObjectPtr<UBtf_TaskForge> ParentTask;
+
+    UPROPERTY(Transient)
+    TObjectPtr<UBtf_TaskForge> FirstChildTask;
+
+    UPROPERTY(Transient)
+    TObjectPtr<UBtf_TaskForge> NextSiblingTask;
+
+    UPROPERTY(Transient)
+    TObjectPtr<UBtf_TaskForge> PrevSiblingTask;
+
+    // Only used on the class defaults, see Get_ImplementsScriptEvent
+    mutable EBtf_TaskScriptEvents ScriptEvents = EBtf_TaskScriptEvents::None;
+    mutable bool ScriptEventsBuilt = false;
+
+    // Set from the constructor of native tasks, shared by every instance of the class
+    const FBtf_NativeTaskDispatch* NativeDispatch = nullptr;
+
+    // Index of the task in the native tick list of its world subsystem while it ticks, INDEX_NONE otherwise
+    int32 NativeTickIndex = INDEX_NONE;
+
+    // Node that spawned the task and how it handles being executed again, only set by the node factory
+    FGuid ReentrancyNodeGuid;
+    EBtf_TaskReentrancyPolicy ReentrancyPolicy = EBtf_TaskReentrancyPolicy::Parallel;
+
+    // Outer the node slot was claimed under, a pooled task has already been moved under the subsystem when it releases it
+    TWeakObjectPtr<UObject> ReentrancyOuter;
+
+    // Ticket of the task in the queue of its node slot while it waits there, INDEX_NONE otherwise
+    int32 NodeQueueTicket = INDEX_NONE;
+
+    // Outer whose name counter numbered the task, the counter is dropped once none of its tasks are left
+    TObjectKey<UObject> NameCounterOuter;
+
+    // Slot of the task in the registry of its world subsystem while it is tracked
+    int32 RegistrySlot = INDEX_NONE;
+
+    // Only used on instance templates, built on the first spawn from the template. @InChangingProperties are
+    // part of the delta even while they match the class defaults, their value is set again before every spawn
+    void BuildTemplateDelta(TConstArrayView<FName> InChangingProperties = {}) const;
+
+    mutable TArray<const FProperty*> TemplateDelta;
+    mutable bool TemplateDeltaBuilt = false;
+    mutable bool TemplateDeltaHasInstancedReferences = false;
+    mutable bool TemplateDeltaCoversChangingProperties = false;
 };
 
 // --------------------------------------------------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,71 @@
+// Copyright (c) 2025 BlueprintTaskForge Maintainers
+//
+// This file is part of the BlueprintTaskForge Plugin for Unreal Engine.
+//
+// Licensed under the BlueprintTaskForge Open Plugin License v1.0 (BTFPL-1.0).
+// You may obtain a copy of the license at:
+// https://github.com/CommitAndChill/BlueprintTaskForge/blob/main/LICENSE.md
+//
+// SPDX-License-Identifier: BTFPL-1.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BftMacros.h"
+
+#include "BtfTaskHandle.generated.h"
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/* Reference to an active task, issued by the task registry of its world.
+ * Resolving it is a single array access and a generation check. The generation of a slot changes every time
+ * a task leaves it, so a handle never resolves to a task that was deactivated, pooled and reused since.
+ * The handle also carries the serial of the registry that issued it, so it never resolves in another world
+ * or in the same world once its registry has been reset. */
+USTRUCT(BlueprintType)
+struct BLUEPRINTTASKFORGE_API FBtf_TaskHandle
+{
+    GENERATED_BODY()
+
+public:
+    FBtf_TaskHandle() = default;
+    FBtf_TaskHandle(const int32 InRegistrySerial, const int32 InSlotIndex, const int32 InGeneration)
+        : RegistrySerial(InRegistrySerial)
+        , SlotIndex(InSlotIndex)
+        , Generation(InGeneration)
+    {
+    }
+
+    bool IsSet() const { return SlotIndex != INDEX_NONE; }
+
+    auto Get_RegistrySerial() const -> int32 { return RegistrySerial; }
+    auto Get_SlotIndex() const -> int32 { return SlotIndex; }
+    auto Get_Generation() const -> int32 { return Generation; }
+
+    bool operator==(const FBtf_TaskHandle& InOther) const
+    {
+        return RegistrySerial == InOther.RegistrySerial
+            && SlotIndex == InOther.SlotIndex
+            && Generation == InOther.Generation;
+    }
+
+    bool operator!=(const FBtf_TaskHandle& InOther) const { return NOT (*this == InOther); }
+
+    friend uint32 GetTypeHash(const FBtf_TaskHandle& InHandle)
+    {
+        return HashCombine(HashCombine(::GetTypeHash(InHandle.RegistrySerial), ::GetTypeHash(InHandle.SlotIndex)),
+            ::GetTypeHash(InHandle.Generation));
+    }
+
+private:
+    UPROPERTY()
+    int32 RegistrySerial = 0;
+
+    UPROPERTY()
+    int32 SlotIndex = INDEX_NONE;
+
+    UPROPERTY()
+    int32 Generation = 0;
+};
+
+// --------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,46 @@
+// Copyright (c) 2025 BlueprintTaskForge Maintainers
+//
+// This file is part of the BlueprintTaskForge Plugin for Unreal Engine.
+//
+// Licensed under the BlueprintTaskForge Open Plugin License v1.0 (BTFPL-1.0).
+// You may obtain a copy of the license at:
+// https://github.com/CommitAndChill/BlueprintTaskForge/blob/main/LICENSE.md
+//
+// SPDX-License-Identifier: BTFPL-1.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPtr.h"
+
+#include "BtfTaskPreloadManifest.generated.h"
+
+class UBtf_TaskForge;
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/* Every task class spawned by the task nodes of a Blueprint, generated when the Blueprint compiles and stored
+ * as a subobject of its generated class. Used by the world subsystem to load and warm up task classes
+ * before their first spawn. */
+UCLASS()
+class BLUEPRINTTASKFORGE_API UBtf_TaskPreloadManifest : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    static const FName ManifestName;
+
+    /* Appends the task classes listed in the manifests of @InClass and its parent classes to @OutClassPaths. */
+    static void CollectTaskClasses(const UClass* InClass, TArray<FSoftObjectPath>& OutClassPaths);
+
+#if WITH_EDITOR
+    /* Replaces the manifest of @InOwnerClass with @InTaskClasses, removing it if there are none. */
+    static void Set(UClass* InOwnerClass, TArray<TSoftClassPtr<UBtf_TaskForge>> InTaskClasses);
+#endif
+
+private:
+    UPROPERTY()
+    TArray<TSoftClassPtr<UBtf_TaskForge>> TaskClasses;
+};
+
+// --------------------------------------------------------------------------------------------------------------------
@@ -16,6 +16,27 @@
 
 // --------------------------------------------------------------------------------------------------------------------
 
+UENUM()
+enum class EBtf_TaskNamingMode : uint8
+{
+    /* Every task gets a globally unique name, the most expensive mode and
+     * every name is a new entry in the name table. */
+    GloballyUnique,
+
+    /* Tasks are named like any other object spawned without a name,
+     * "<ClassName>_<Number>", which only reuses the class name entry. */
+    Anonymous,
+
+    /* Like Anonymous, but numbered per outer starting from zero. */
+    PerOuterCounter,
+
+    /* Like Anonymous, but outside of shipping builds a readable name
+     * (task class and outer) is kept in a side table of the world subsystem. */
+    DebugNames
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
 UCLASS(Config = Game, DefaultConfig, DisplayName = "Blueprint Task Forge Runtime Settings")
 class BLUEPRINTTASKFORGE_API UBtf_RuntimeSettings : public UDeveloperSettings
 {
@@ -30,6 +51,36 @@ public:
     UPROPERTY(Category = "Node Settings", EditAnywhere, Config)
     bool ShowNodeDescriptionWhilePlaying = false;
 
+    /* Allows task classes that opted into pooling ("Allow Pooling" in
+     * the task class defaults) to be recycled once they deactivate,
+     * instead of being marked as garbage and constructed again. */
+    UPROPERTY(Category = "Performance", EditAnywhere, Config)
+    bool EnableTaskPooling = false;
+
+    /* How many idle tasks of a single class are kept per world.
+     * Tasks deactivating while the pool is full are destroyed as usual. */
+    UPROPERTY(Category = "Performance", EditAnywhere, Config, meta = (EditCondition = "EnableTaskPooling", ClampMin = "0"))
+    int32 MaxPooledTasksPerClass = 32;
+
+    UPROPERTY(Category = "Performance", EditAnywhere, Config)
+    EBtf_TaskNamingMode TaskNamingMode = EBtf_TaskNamingMode::GloballyUnique;
+
+    /* Loads and warms up the task classes used by the Blueprints of a level while it is
+     * added to the world, so the first spawn of a task class does not hitch. */
+    UPROPERTY(Category = "Performance", EditAnywhere, Config)
+    bool PreloadTaskClasses = false;
+
+    /* Tasks whose actor outer is destroyed are deactivated by the world subsystem over the
+     * following frames instead of right away, so destroying many actors at once does not spike.
+     * Their Deactivate event still runs, but their actor is already marked as garbage by then:
+     * it fails IsValid and its components may have been unregistered. */
+    UPROPERTY(Category = "Performance", EditAnywhere, Config)
+    bool DeferDeactivationOfDestroyedOuters = false;
+
+    /* Time spent per frame deactivating deferred tasks, at least one task is always deactivated. */
+    UPROPERTY(Category = "Performance", EditAnywhere, Config, meta = (EditCondition = "DeferDeactivationOfDestroyedOuters", ClampMin = "0", Units = "ms"))
+    float DeferredDeactivationBudgetMs = 1.0f;
+
     virtual FName GetSectionName() const override;
     virtual FName GetCategoryName() const override;
 };
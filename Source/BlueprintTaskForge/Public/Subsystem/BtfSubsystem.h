@@ -12,10 +12,14 @@
 
 #include "BtfTaskForge.h"
 #include "BftMacros.h"
+#include "Subsystem/BtfTaskRegistry.h"
 
+#include <Engine/EngineTypes.h>
 #include <Subsystems/EngineSubsystem.h>
 #include <Subsystems/WorldSubsystem.h>
 
+struct FStreamableHandle;
+
 #include "BtfSubsystem.generated.h"
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -30,25 +34,297 @@ struct FBtf_OutersBlueprintTasksArrayWrapper
 
 // --------------------------------------------------------------------------------------------------------------------
 
+/* Node templates (task instances stored as Blueprint extensions) reachable from a single class,
+ * including the ones inherited from its parent Blueprints. */
+struct FBtf_NodeTemplateIndex
+{
+    TMap<FGuid, TWeakObjectPtr<UBtf_TaskForge>> TemplatesByNodeGuid;
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/* Spawn param names of a node as passed to ApplySpawnParams, for the class they are applied to. */
+struct FBtf_SpawnParamLayoutKey
+{
+    TObjectKey<UClass> Class;
+    TArray<FName> PropertyNames;
+
+    static uint32 Hash(const TObjectKey<UClass>& InClass, TConstArrayView<FName> InPropertyNames);
+
+    friend uint32 GetTypeHash(const FBtf_SpawnParamLayoutKey& InKey) { return Hash(InKey.Class, InKey.PropertyNames); }
+    friend bool operator==(const FBtf_SpawnParamLayoutKey& InLhs, const FBtf_SpawnParamLayoutKey& InRhs)
+    { return InLhs.Class == InRhs.Class && InLhs.PropertyNames == InRhs.PropertyNames; }
+};
+
+/* Same as FBtf_SpawnParamLayoutKey without owning the names, so that looking a layout up does not allocate. */
+struct FBtf_SpawnParamLayoutLookup
+{
+    TObjectKey<UClass> Class;
+    TConstArrayView<FName> PropertyNames;
+
+    friend bool operator==(const FBtf_SpawnParamLayoutKey& InLhs, const FBtf_SpawnParamLayoutLookup& InRhs)
+    {
+        return InLhs.Class == InRhs.Class && InLhs.PropertyNames.Num() == InRhs.PropertyNames.Num() &&
+            CompareItems(InLhs.PropertyNames.GetData(), InRhs.PropertyNames.GetData(), InRhs.PropertyNames.Num());
+    }
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+USTRUCT()
+struct FBtf_PerOuterTaskInstances
+{
+    GENERATED_BODY()
+
+    UPROPERTY(Transient)
+    TMap<TObjectPtr<UClass>, TObjectPtr<UBtf_TaskForge>> Tasks;
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/* Task of a single node on a single outer that is currently active, and the ones waiting for it
+ * to deactivate if the node queues its executions. */
+USTRUCT()
+struct FBtf_NodeTaskSlot
+{
+    GENERATED_BODY()
+
+    UPROPERTY(Transient)
+    TObjectPtr<UBtf_TaskForge> ActiveTask;
+
+    // Consumed from FirstQueuedTask on, the consumed entries are only compacted once they make up half of the array
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UBtf_TaskForge>> QueuedTasks;
+
+    // Per queued task, the ticket it was queued with. A task dropped from the queue gives its ticket back
+    // and is skipped once its turn comes, instead of being searched for
+    TArray<int32> QueuedTickets;
+
+    int32 FirstQueuedTask = 0;
+    int32 NextTicket = 0;
+};
+
+USTRUCT()
+struct FBtf_NodeTaskSlots
+{
+    GENERATED_BODY()
+
+    UPROPERTY(Transient)
+    TMap<FGuid, FBtf_NodeTaskSlot> SlotsByNodeGuid;
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+USTRUCT()
+struct FBtf_TaskPool
+{
+    GENERATED_BODY()
+
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UBtf_TaskForge>> Tasks;
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+// Number handed out to the next task named under an outer, and how many of the tasks it named are still around
+struct FBtf_TaskNameCounter
+{
+    int32 NextNumber = 0;
+    int32 NumNamedTasks = 0;
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
 UCLASS()
-class BLUEPRINTTASKFORGE_API UBtf_WorldSubsystem : public UWorldSubsystem
+class BLUEPRINTTASKFORGE_API UBtf_WorldSubsystem : public UTickableWorldSubsystem
 {
     GENERATED_BODY()
 
 public:
+    virtual void PostInitialize() override;
     virtual void Deinitialize() override;
 
+    // Only ticks while native tasks are ticking or tasks are waiting to be deactivated
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override;
+    virtual TStatId GetStatId() const override;
+
     void TrackTask(UBtf_TaskForge* InTask);
     void UntrackTask(UBtf_TaskForge* InTask);
 
+    /* Tracks a batch of new tasks at once, growing the registry a single time. */
+    void TrackTasks(TConstArrayView<UBtf_TaskForge*> InTasks);
+
+    FBtf_TaskHandle Get_TaskHandle(const UBtf_TaskForge* InTask) const;
+    UBtf_TaskForge* ResolveTaskHandle(const FBtf_TaskHandle& InHandle) const;
+
+    /* Copy of every tracked task grouped by outer, built on every call.
+     * Prefer the ForEach functions below, which walk the registry in place. */
     TMap<TWeakObjectPtr<UObject>, FBtf_OutersBlueprintTasksArrayWrapper> GetTaskTree();
 
+    /* Visitors return false to stop iterating. The visited task may be untracked from the visitor. */
+    void ForEachTask(FBtf_TaskRegistry::FTaskVisitor InVisitor) const;
+    void ForEachOuter(FBtf_TaskRegistry::FOuterVisitor InVisitor) const;
+    void ForEachTaskOfOuter(const UObject* InOuter, FBtf_TaskRegistry::FTaskVisitor InVisitor) const;
+    void ForEachTaskOfClass(const UClass* InClass, bool InIncludeSubclasses, FBtf_TaskRegistry::FTaskVisitor InVisitor) const;
+    void ForEachTaskWithTag(const FGameplayTag& InTag, FBtf_TaskRegistry::FTaskVisitor InVisitor) const;
+
+    /* Active tasks of exactly @Class, or of @Class and its subclasses if @IncludeSubclasses.
+     * @OutTasks is emptied first. Blueprint callers get a new array every call, use the ForEach functions above
+     * to walk the tasks from C++ without allocating. */
+    UFUNCTION(Category = "BlueprintTaskForge", BlueprintCallable)
+    void GetActiveTasksOfClass(TSubclassOf<UBtf_TaskForge> Class, bool IncludeSubclasses, TArray<UBtf_TaskForge*>& OutTasks) const;
+
+    /* Active tasks outered to @Outer, see @GetActiveTasksOfClass. */
+    UFUNCTION(Category = "BlueprintTaskForge", BlueprintCallable)
+    void GetActiveTasksOfOuter(const UObject* Outer, TArray<UBtf_TaskForge*>& OutTasks) const;
+
+    UFUNCTION(Category = "BlueprintTaskForge", BlueprintCallable, BlueprintPure)
+    int32 CountActiveTasksOfClass(TSubclassOf<UBtf_TaskForge> Class, bool IncludeSubclasses) const;
+
+    UFUNCTION(Category = "BlueprintTaskForge", BlueprintCallable, BlueprintPure)
+    int32 CountActiveTasksOfOuter(const UObject* Outer) const;
+
+    /* Active tasks tagged with @Tag or one of its child tags, limited to the ones nested in @Outer if set.
+     * Only the tasks carrying the tag are visited. */
+    UFUNCTION(Category = "BlueprintTaskForge", BlueprintCallable, meta = (AdvancedDisplay = "Outer"))
+    void GetActiveTasksWithTag(FGameplayTag Tag, TArray<UBtf_TaskForge*>& OutTasks, const UObject* Outer = nullptr) const;
+
+    /* Deactivates the tasks returned by @GetActiveTasksWithTag, returns how many were deactivated. */
+    UFUNCTION(Category = "BlueprintTaskForge", BlueprintCallable, meta = (AdvancedDisplay = "Outer"))
+    int32 DeactivateTasksWithTag(FGameplayTag Tag, const UObject* Outer = nullptr);
+
+    UFUNCTION(Category = "BlueprintTaskForge", BlueprintCallable, BlueprintPure, meta = (AdvancedDisplay = "Outer"))
+    int32 CountTasksWithTag(FGameplayTag Tag, const UObject* Outer = nullptr) const;
+
+    /* Tasks whose outer is @InObject or nested in it, found through the outers with tasks owned by the same actor
+     * instead of the subobjects of @InObject. Queued executions come first, so that deactivating them in order does
+     * not activate a queued task on the way. An @InObject outside of any actor (a level) walks every outer instead.
+     * Weak, since handling one task can destroy or pool the ones after it. */
+    void CollectTasksRelatedToObject(const UObject* InObject, TArray<TWeakObjectPtr<UBtf_TaskForge>>& OutTasks) const;
+
+    /* Hands out an idle task of exactly @InClass, moved under @InOuter and reset from
+     * @InArchetype (or the class defaults if null). Returns nullptr if the pool is empty. */
+    UBtf_TaskForge* AcquirePooledTask(const UClass* InClass, UObject* InOuter, const UBtf_TaskForge* InArchetype);
+
+    /* Returns false if the pool of the task's class is full, in which case the caller destroys the task. */
+    bool ReturnTaskToPool(UBtf_TaskForge* InTask);
+
+    /* Instance reused by every execution of an InstancedPerOuter task of @InClass under @InOuter. */
+    UBtf_TaskForge* FindPerOuterTask(UObject* InOuter, const UClass* InClass) const;
+    void RegisterPerOuterTask(UBtf_TaskForge* InTask);
+    void ReleasePerOuterTasks(UObject* InOuter);
+
+    /* Task spawned by the node @InNodeGuid on @InOuter that is still active, if the node has a re-entrancy policy. */
+    UBtf_TaskForge* Get_ActiveNodeTask(UObject* InOuter, const FGuid& InNodeGuid) const;
+
+    /* Makes @InTask the active task of its node on its outer. Returns false if the node queues its executions
+     * and another task is still active, @InTask is then activated by the subsystem once it is its turn. */
+    bool ClaimNodeTaskSlot(UBtf_TaskForge* InTask);
+
+    /* Frees the slot held by @InTask (activating the next queued task, if any) or drops it from the queue. */
+    void ReleaseNodeTaskSlot(UBtf_TaskForge* InTask);
+
+    /* Name for a new task of @InClass under @InOuter, following the TaskNamingMode runtime setting. */
+    FName MakeTaskName(UObject* InOuter, const UClass* InClass);
+
+    /* Called once a task has been constructed with a name from @MakeTaskName. */
+    void RegisterTaskName(UBtf_TaskForge* InTask);
+
+    /* Drops the readable name of @InTask and its share of the name counter of its outer, once it is destroyed
+     * or parked in a pool. */
+    void UnregisterTaskName(UBtf_TaskForge* InTask);
+
+    /* Readable name of the task, only differs from the object name in DebugNames mode. */
+    FString Get_TaskDebugName(const UBtf_TaskForge* InTask) const;
+
+    /* Deactivates the tasks of @InOuter (and of any other outer nested in the same actor) once that actor is
+     * destroyed. Each actor is bound once, no matter how many tasks it and its components run. An actor that ends
+     * play without being destroyed is unbound, its tasks are released by the teardown of its level or world. */
+    void BindOuterLifetime(UObject* InOuter);
+
+    /* Releases every task whose outer is in @InLevel, or every task of the world if null, in a single pass over
+     * the registry. Queued executions are dropped and Deactivate only runs for classes with DeactivateOnTeardown.
+     * Tasks waiting in the deferred deactivation queue are deactivated first, whatever level they are in. */
+    void TeardownTasks(const ULevel* InLevel);
+
+    /* Ticks the native tick of @InTask from the subsystem's tick until @StopNativeTick, starting next frame. */
+    void StartNativeTick(UBtf_TaskForge* InTask);
+    void StopNativeTick(UBtf_TaskForge* InTask);
+
+    /* Deactivates @InTask from a later tick, within the DeferredDeactivationBudgetMs runtime setting. */
+    void QueueDeferredDeactivation(UBtf_TaskForge* InTask);
+
+    /* Deactivates the queued tasks, grouped by class, until the queue is empty or @InBudgetSeconds have passed.
+     * A negative budget drains the whole queue. */
+    void DrainDeferredDeactivations(double InBudgetSeconds);
+
+    /* Loads the task classes listed in the preload manifests of @InClass and its parents, then warms them up.
+     * The classes are kept loaded for the lifetime of the world. */
+    void PreloadTaskClasses(const UClass* InClass);
+
+    /* Same as @PreloadTaskClasses for the level script and every actor class of @InLevel. */
+    void PreloadLevelTaskClasses(const ULevel* InLevel);
+
 private:
+    void RequestTaskClassPreload(TArray<FSoftObjectPath> InClassPaths);
+    void WarmUpTaskClasses(TConstArrayView<FSoftObjectPath> InClassPaths);
+    void OnLevelAddedToWorld(ULevel* InLevel, UWorld* InWorld);
+    void OnWorldBeginTearDown(UWorld* InWorld);
+    void OnLevelRemovedFromWorld(ULevel* InLevel, UWorld* InWorld);
+
+    UFUNCTION()
+    void OnOuterActorDestroyed(AActor* InActor);
+
+    UFUNCTION()
+    void OnOuterActorEndPlay(AActor* InActor, EEndPlayReason::Type InEndPlayReason);
+
+    void UnbindOuterLifetime(AActor* InActor);
+    void TickNativeTasks(float InDeltaTime);
+
     UPROPERTY(Transient)
-    TSet<TObjectPtr<UBtf_TaskForge>> BlueprintTasks;
+    FBtf_TaskRegistry TaskRegistry;
 
-    UPROPERTY()
-    TMap<TWeakObjectPtr<UObject>, FBtf_OutersBlueprintTasksArrayWrapper> ObjectsAndTheirTasks;
+    UPROPERTY(Transient)
+    TMap<TObjectPtr<UClass>, FBtf_TaskPool> TaskPools;
+
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UBtf_TaskForge>> DeferredDeactivations;
+
+    // Tasks queued since the queue was last sorted by class
+    bool DeferredDeactivationsSorted = true;
+
+    // Active native tasks that tick, each one knows its index. Stopped entries are compacted after the tick.
+    TArray<TWeakObjectPtr<UBtf_TaskForge>> NativeTickingTasks;
+    bool IsTickingNativeTasks = false;
+
+    TSet<TObjectKey<AActor>> ActorsWithLifetimeHook;
+
+    UPROPERTY(Transient)
+    TMap<TWeakObjectPtr<UObject>, FBtf_PerOuterTaskInstances> PerOuterTaskInstances;
+
+    // The outers of PerOuterTaskInstances grouped by owning actor, so that destroying an actor only visits its own
+    TMap<TObjectKey<AActor>, TArray<TWeakObjectPtr<UObject>>> PerOuterTaskInstanceOutersByActor;
+
+    UPROPERTY(Transient)
+    TMap<TWeakObjectPtr<UObject>, FBtf_NodeTaskSlots> NodeTaskSlotsPerOuter;
+
+    // Sizes the maps above have to reach before their entries of destroyed outers are swept
+    int32 PerOuterTaskInstancesSweepThreshold = 0;
+    int32 NodeTaskSlotsSweepThreshold = 0;
+    int32 TaskNameCountersSweepThreshold = 0;
+
+    TMap<TObjectKey<UObject>, FBtf_TaskNameCounter> TaskNameCountersPerOuter;
+
+    TSet<FSoftObjectPath> PreloadedTaskClasses;
+    TArray<TSharedPtr<FStreamableHandle>> TaskClassPreloadHandles;
+    FDelegateHandle LevelAddedToWorldHandle;
+    FDelegateHandle WorldBeginTearDownHandle;
+    FDelegateHandle PreLevelRemovedFromWorldHandle;
+
+#if !UE_BUILD_SHIPPING
+    TMap<TObjectKey<UBtf_TaskForge>, FString> TaskDebugNames;
+#endif
 };
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -66,7 +342,30 @@ public:
 
     UBtf_TaskForge* FindTaskInstanceWithGuid(FGuid InTaskNodeGuid);
 
+    /* Finds the node template for @InNodeGuid on @InOuterClass or any of its parent classes.
+     * The lookup table of a class is built on first use and kept until invalidated. */
+    UBtf_TaskForge* FindNodeTemplate(const UClass* InOuterClass, const FGuid& InNodeGuid);
+    bool IsNodeTemplate(const UBtf_TaskForge* InTask);
+
+    /* Must be called whenever node templates are added to or removed from a Blueprint,
+     * or a Blueprint is recompiled. */
+    void InvalidateNodeTemplates();
+
+    /* Properties of @InClass named by @InPropertyNames, in the same order and null for the ones that do not exist.
+     * Resolved once per class and list of names, every later call is a single lookup. */
+    const TArray<const FProperty*>& FindSpawnParamProperties(const UClass* InClass, TConstArrayView<FName> InPropertyNames);
+
+    /* Must be called whenever classes are recompiled, their properties are recreated. */
+    void InvalidateSpawnParamProperties();
+
 private:
+    const FBtf_NodeTemplateIndex& GetOrBuildNodeTemplateIndex(const UClass* InOuterClass);
+
+    TMap<TObjectKey<UClass>, FBtf_NodeTemplateIndex> NodeTemplateIndices;
+    TSet<TObjectKey<UBtf_TaskForge>> NodeTemplates;
+
+    TMap<FBtf_SpawnParamLayoutKey, TArray<const FProperty*>> SpawnParamLayouts;
+
 #if WITH_EDITORONLY_DATA
     UPROPERTY()
     TMap<FGuid, TWeakObjectPtr<UBtf_TaskForge>> TaskNodeGuidToTaskInstance;
@@ -0,0 +1,153 @@
+// Copyright (c) 2025 BlueprintTaskForge Maintainers
+//
+// This file is part of the BlueprintTaskForge Plugin for Unreal Engine.
+//
+// Licensed under the BlueprintTaskForge Open Plugin License v1.0 (BTFPL-1.0).
+// You may obtain a copy of the license at:
+// https://github.com/CommitAndChill/BlueprintTaskForge/blob/main/LICENSE.md
+//
+// SPDX-License-Identifier: BTFPL-1.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "BtfTaskHandle.h"
+#include "GameplayTagContainer.h"
+
+#include "BtfTaskRegistry.generated.h"
+
+class AActor;
+class UBtf_TaskForge;
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/* Tasks tracked by a world subsystem, stored as parallel arrays indexed by slot.
+ * Freed slots are recycled through a free list and every task knows its own slot,
+ * tracking and untracking a task are constant time and iterating walks contiguous memory.
+ * Outers and classes are interned into tables, slots only store their index. */
+USTRUCT()
+struct BLUEPRINTTASKFORGE_API FBtf_TaskRegistry
+{
+    GENERATED_BODY()
+
+public:
+    void Add(UBtf_TaskForge* InTask);
+
+    /* Returns true if @InTask was the last tracked task of its outer. */
+    bool Remove(UBtf_TaskForge* InTask);
+
+    bool Contains(const UBtf_TaskForge* InTask) const;
+    int32 Num() const { return Tasks.Num() - FreeSlots.Num(); }
+
+    /* Handle to @InTask while it is tracked, unset otherwise. */
+    FBtf_TaskHandle Get_Handle(const UBtf_TaskForge* InTask) const;
+
+    /* The task @InHandle was issued for, null if it has been untracked since. */
+    UBtf_TaskForge* Resolve(const FBtf_TaskHandle& InHandle) const;
+
+    void Reserve(int32 InNumTasks);
+    void Reset();
+
+    /* Visitors return false to stop iterating. Nothing is copied, the registry is walked in place:
+     * the visited task may be untracked from the visitor, tasks tracked meanwhile may or may not be visited. */
+    using FTaskVisitor = TFunctionRef<bool(UBtf_TaskForge& InTask)>;
+    using FOuterVisitor = TFunctionRef<bool(UObject& InOuter, int32 InNumTasks)>;
+
+    void ForEachTask(FTaskVisitor InVisitor) const;
+
+    /* Outers with at least one tracked task, in no particular order. */
+    void ForEachOuter(FOuterVisitor InVisitor) const;
+
+    /* Outers with tracked tasks whose owning actor (see @Get_OwningActor) is @InActor, without touching the outers
+     * of other actors. A null @InActor walks the outers that are not part of any actor. */
+    void ForEachOuterOfActor(const AActor* InActor, FOuterVisitor InVisitor) const;
+
+    /* @InObject if it is an actor, otherwise the actor it is nested in, if any. */
+    static const AActor* Get_OwningActor(const UObject* InObject);
+
+    /* Walks the slots of @InOuter only, without touching the tasks of other outers. */
+    void ForEachTaskOfOuter(const UObject* InOuter, FTaskVisitor InVisitor) const;
+
+    /* Walks the slots of @InClass only, and of its tracked subclasses if @InIncludeSubclasses. */
+    void ForEachTaskOfClass(const UClass* InClass, bool InIncludeSubclasses, FTaskVisitor InVisitor) const;
+
+    /* Walks the tasks tagged with @InTag or one of its child tags, without touching untagged tasks. */
+    void ForEachTaskWithTag(const FGameplayTag& InTag, FTaskVisitor InVisitor) const;
+
+    int32 Num_TasksOfOuter(const UObject* InOuter) const;
+    int32 Num_TasksOfClass(const UClass* InClass, bool InIncludeSubclasses) const;
+
+private:
+    int32 FindOrAddOuter(UObject* InOuter);
+    int32 FindOrAddClass(const UClass* InClass);
+    void ReleaseOuter(int32 InOuterIndex);
+    void ReleaseClass(int32 InClassIndex);
+    void LinkToActor(int32 InOuterIndex, const AActor* InActor);
+    void UnlinkFromActor(int32 InOuterIndex);
+    void LinkToOuter(int32 InSlot, int32 InOuterIndex);
+    void UnlinkFromOuter(int32 InSlot, int32 InOuterIndex);
+    void LinkToClass(int32 InSlot, int32 InClassIndex);
+    void UnlinkFromClass(int32 InSlot, int32 InClassIndex);
+    void AddTags(int32 InSlot, const FGameplayTagContainer& InTags);
+    void RemoveTags(int32 InSlot);
+
+    // Visits the index of @InClass, and of its subclasses if @InIncludeSubclasses, stops once @InVisitor returns false
+    void ForEachClassIndex(const UClass* InClass, bool InIncludeSubclasses, TFunctionRef<bool(int32 InClassIndex)> InVisitor) const;
+
+    // Per slot, null for free slots
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UBtf_TaskForge>> Tasks;
+
+    // Per slot
+    TArray<int32> OuterIndices;
+    TArray<int32> ClassIndices;
+
+    // Per slot, links the slots of the same outer together
+    TArray<int32> NextSlotsOfOuter;
+    TArray<int32> PrevSlotsOfOuter;
+
+    // Per slot, links the slots of the same class together
+    TArray<int32> NextSlotsOfClass;
+    TArray<int32> PrevSlotsOfClass;
+
+    // Per slot, the task's tags and their parents as they were when the task was tracked,
+    // each with the position of the slot in the matching SlotsByTag array
+    TArray<TArray<TPair<FGameplayTag, int32>>> TagPositionsOfSlot;
+
+    // Every tag and parent tag of the tracked tasks, to the slots tagged with it. Emptied arrays are kept,
+    // the set of tags a project uses is small and stable
+    TMap<FGameplayTag, TArray<int32>> SlotsByTag;
+
+    // Per slot, bumped every time a task leaves the slot so that handles to it go stale
+    TArray<int32> Generations;
+
+    // Unique across every registry of the process, drawn when the first task is tracked after a reset so that
+    // handles issued by another registry, or by this one before the reset, go stale. 0 while empty
+    int32 Serial = 0;
+
+    TArray<int32> FreeSlots;
+
+    // Per outer index
+    TArray<TWeakObjectPtr<UObject>> Outers;
+    TArray<TObjectKey<UObject>> OuterKeys;
+    TArray<int32> OuterTaskCounts;
+    TArray<int32> FirstSlotsOfOuter;
+    TArray<int32> FreeOuters;
+    TMap<TObjectKey<UObject>, int32> OuterIndicesByKey;
+
+    // Per outer index, links the outers owned by the same actor together
+    TArray<TObjectKey<AActor>> OuterActors;
+    TArray<int32> NextOutersOfActor;
+    TArray<int32> PrevOutersOfActor;
+    TMap<TObjectKey<AActor>, int32> FirstOuterOfActor;
+
+    // Per class index, released once the last task of the class is untracked
+    TArray<TObjectKey<UClass>> Classes;
+    TArray<int32> ClassTaskCounts;
+    TArray<int32> FirstSlotsOfClass;
+    TArray<int32> FreeClasses;
+    TMap<TObjectKey<UClass>, int32> ClassIndicesByKey;
+};
+
+// --------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,50 @@
+// Copyright (c) 2025 BlueprintTaskForge Maintainers
+//
+// This file is part of the BlueprintTaskForge Plugin for Unreal Engine.
+//
+// Licensed under the BlueprintTaskForge Open Plugin License v1.0 (BTFPL-1.0).
+// You may obtain a copy of the license at:
+// https://github.com/CommitAndChill/BlueprintTaskForge/blob/main/LICENSE.md
+//
+// SPDX-License-Identifier: BTFPL-1.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BtfTaskForge.h"
+#include "Engine/TimerHandle.h"
+
+#include "BtfDelayTask.generated.h"
+
+// --------------------------------------------------------------------------------------------------------------------
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FBtf_DelayTaskDelegate);
+
+/* Fires OnCompleted once @Duration seconds have passed since it was activated, then deactivates itself.
+ * Written in C++ only, @Start spawns it through the typed native spawn API (see BtfSpawnTask.h). */
+UCLASS(DisplayName = "Delay Task")
+class BLUEPRINTTASKFORGE_API UBtf_DelayTask : public UBtf_TaskForge
+{
+    GENERATED_BODY()
+
+public:
+    /* Spawns and activates a delay of @InDuration seconds on @InOuter. */
+    static UBtf_DelayTask* Start(UObject* InOuter, float InDuration);
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BlueprintTaskForge", meta = (ExposeOnSpawn, ClampMin = "0"))
+    float Duration = 1.0f;
+
+    UPROPERTY(BlueprintAssignable, Category = "BlueprintTaskForge")
+    FBtf_DelayTaskDelegate OnCompleted;
+
+protected:
+    virtual void Activate_Internal() override;
+    virtual void Deactivate_Internal() override;
+
+private:
+    void OnDelayElapsed();
+
+    FTimerHandle DelayTimerHandle;
+};
+
+// --------------------------------------------------------------------------------------------------------------------
@@ -18,11 +18,13 @@
 #include "BlueprintCompilationManager.h"
 #include "BtfTaskForge.h"
 #include "BtfTaskForge_K2Node.h"
+#include "BtfTaskPreloadCompilerExtension.h"
 #include "PropertyEditorDelegates.h"
 #include "PropertyEditorModule.h"
 #include "AssetRegistry/ARFilter.h"
 #include "NodeCustomizations/BtfNameSelectStructCustomization.h"
 #include "NodeCustomizations/BtfNodeDetailsCustomizations.h"
+#include "Subsystem/BtfSubsystem.h"
 
 // --------------------------------------------------------------------------------------------------------------------
 
@@ -44,6 +46,10 @@ void FBlueprintTaskForgeEditorModule::StartupModule()
 
     OnObjectPropertyChangedDelegateHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FBlueprintTaskForgeEditorModule::OnObjectPropertyChanged);
 
+    // Runs once per compiled Blueprint, after all of its nodes have been expanded
+    TaskPreloadCompilerExtension.Reset(NewObject<UBtf_TaskPreloadCompilerExtension>(GetTransientPackage()));
+    FBlueprintCompilationManager::RegisterCompilerExtension(UBlueprint::StaticClass(), TaskPreloadCompilerExtension.Get());
+
     PropertyModule.RegisterCustomClassLayout(
         UBtf_TaskForge_K2Node::StaticClass()->GetFName(),
         FOnGetDetailCustomizationInstance::CreateStatic(&FBtf_NodeDetailsCustomizations::MakeInstance)
@@ -62,10 +68,28 @@ void FBlueprintTaskForgeEditorModule::ShutdownModule()
     }
 
     FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(OnObjectPropertyChangedDelegateHandle);
+
+    if (TaskPreloadCompilerExtension.IsValid())
+    {
+        TaskPreloadCompilerExtension->Release();
+        TaskPreloadCompilerExtension.Reset();
+    }
 }
 
 void FBlueprintTaskForgeEditorModule::OnBlueprintCompiled()
 {
+    if (IsValid(GEngine))
+    {
+        if (const auto& BlueprintTaskEngineSubsystem = GEngine->GetEngineSubsystem<UBtf_EngineSubsystem>();
+            IsValid(BlueprintTaskEngineSubsystem))
+        {
+            BlueprintTaskEngineSubsystem->InvalidateNodeTemplates();
+            BlueprintTaskEngineSubsystem->InvalidateSpawnParamProperties();
+        }
+    }
+
+    UBtf_TaskForge::InvalidateScriptEvents();
+
     RefreshClassActions();
 }
 
@@ -38,6 +38,9 @@
 #include "K2Node_Self.h"
 #include "K2Node_CreateDelegate.h"
 #include "K2Node_EditablePinBase.h"
+#include "K2Node_Literal.h"
+#include "K2Node_MakeArray.h"
+#include "K2Node_ExecutionSequence.h"
 
 #include "KismetCompiler.h"
 #include "Kismet/KismetSystemLibrary.h"
@@ -45,6 +48,9 @@
 #include "BlueprintNodeSpawner.h"
 #include "BlueprintActionDatabaseRegistrar.h"
 #include "BtfTaskForge.h"
+#include "BtfTaskPreloadManifest.h"
+#include "BtfSpawnTaskBatch_K2Node.h"
+#include "Subsystem/BtfSubsystem.h"
 #include "DetailLayoutBuilder.h"
 #include "K2Node_BreakStruct.h"
 
@@ -153,6 +159,10 @@ void UBtf_ExtendConstructObject_K2Node::PostEditChangeProperty(FPropertyChangedE
         if (OwnerContextPin)
         { SelfContext = false; }
     }
+    else if (PropertyName == GET_MEMBER_NAME_CHECKED(UBtf_ExtendConstructObject_K2Node, LoadClassAsynchronously))
+    {
+        NeedReconstruct = true;
+    }
     else if (PropertyName == GET_MEMBER_NAME_CHECKED(UBtf_ExtendConstructObject_K2Node, AllowInstance))
     {
         NeedReconstruct = true;
@@ -197,6 +207,15 @@ void UBtf_ExtendConstructObject_K2Node::PostEditChangeProperty(FPropertyChangedE
             }
         }
 
+        if (IsValid(GEngine))
+        {
+            if (const auto& BlueprintTaskEngineSubsystem = GEngine->GetEngineSubsystem<UBtf_EngineSubsystem>();
+                IsValid(BlueprintTaskEngineSubsystem))
+            {
+                BlueprintTaskEngineSubsystem->InvalidateNodeTemplates();
+            }
+        }
+
         if (DetailsPanelBuilder)
         { DetailsPanelBuilder->ForceRefreshDetails(); }
     }
@@ -523,6 +542,76 @@ void UBtf_ExtendConstructObject_K2Node::ValidateNodeDuringCompilation(FCompilerR
                  FText::FromString(GetPathNameSafe(ProxyClass))).ToString(), this);
     }
 
+    // Non-instanced tasks run on the class defaults, which are shared by every node and cannot hold per-node state
+    if (IsValid(ProxyClass) && ProxyClass->GetDefaultObject<UBtf_TaskForge>()->InstancingPolicy == EBtf_TaskInstancingPolicy::NonInstanced)
+    {
+        auto UsesPerNodeState = AllowInstance || CustomPins.Num() > 0 || InDelegate.Num() > 0 || OutDelegate.Num() > 0;
+        for (const auto& FunctionName : ExecFunction)
+        {
+            UsesPerNodeState |= FunctionName.Name != TEXT("Deactivate");
+        }
+        for (const auto& PinParamName : SpawnParam)
+        {
+            if (const auto* SpawnVarPin = FindPin(PinParamName.Name);
+                SpawnVarPin != nullptr)
+            {
+                UsesPerNodeState |= SpawnVarPin->LinkedTo.Num() > 0 || SpawnVarPin->DefaultValue != SpawnVarPin->AutogeneratedDefaultValue;
+            }
+        }
+
+        if (UsesPerNodeState)
+        {
+            MessageLog.Error(
+                *FText::Format(
+                     LOCTEXT("ExtendConstructObjectNonInstanced", "{0} is not instanced, it cannot use delegates, custom pins, exec functions, spawn params or a node instance. @@"),
+                     FText::FromString(GetPathNameSafe(ProxyClass))).ToString(), this);
+        }
+    }
+
+    // Anything of a Blueprint task class that the compiled graph would have to reference directly defeats loading it by path
+    if (LoadClassAsynchronously && IsValid(ProxyClass))
+    {
+        const auto ReportError = [&](const FText& InReason)
+        {
+            MessageLog.Error(
+                *FText::Format(
+                     LOCTEXT("ExtendConstructObjectLoadAsync", "{0} is loaded asynchronously, {1} @@"),
+                     FText::FromString(GetPathNameSafe(ProxyClass)),
+                     InReason).ToString(), this);
+        };
+
+        if (GetSchema()->GetGraphType(GetGraph()) == GT_Function)
+        {
+            ReportError(LOCTEXT("ExtendConstructObjectLoadAsyncFunction", "which is only possible in an event graph."));
+        }
+
+        if (AllowInstance)
+        {
+            ReportError(LOCTEXT("ExtendConstructObjectLoadAsyncInstance", "it can not have a node instance."));
+        }
+
+        for (const auto& DelegateName : InDelegate)
+        {
+            if (const auto* Property = ProxyClass->FindPropertyByName(DelegateName.Name);
+                Property != nullptr && IsReferencedByPath(Property->GetOwnerClass()))
+            {
+                ReportError(FText::Format(LOCTEXT("ExtendConstructObjectLoadAsyncInDelegate", "the delegate '{0}' is declared in Blueprint and can not be assigned."), FText::FromName(DelegateName.Name)));
+            }
+        }
+
+        for (const auto& FunctionNames : {AutoCallFunction, ExecFunction})
+        {
+            for (const auto& FunctionName : FunctionNames)
+            {
+                if (const auto* Function = ProxyClass->FindFunctionByName(FunctionName.Name);
+                    IsValid(Function) && IsReferencedByPath(Function->GetOwnerClass()))
+                {
+                    ReportError(FText::Format(LOCTEXT("ExtendConstructObjectLoadAsyncFunctionCall", "the function '{0}' is declared in Blueprint and can not be called."), FText::FromName(FunctionName.Name)));
+                }
+            }
+        }
+    }
+
     if (auto* Task = GetInstanceOrDefaultObject())
     {
         const auto Errors = Task->ValidateNodeDuringCompilation();
@@ -631,7 +720,7 @@ FLinearColor UBtf_ExtendConstructObject_K2Node::GetNodeTitleColor() const
     auto CustomColor = FLinearColor{};
     if (const auto& TaskObject = GetInstanceOrDefaultObject();
     	IsValid(TaskObject) &&
-    	TaskObject->Get_NodeTitleColor(CustomColor))
+    	TaskObject->Query_NodeTitleColor(CustomColor))
     { return CustomColor; }
 
     return Super::GetNodeTitleColor();
@@ -844,6 +933,15 @@ void UBtf_ExtendConstructObject_K2Node::DestroyNode()
         GetBlueprint()->RemoveExtension(TaskInstance);
         TaskInstance->MarkAsGarbage();
         TaskInstance = nullptr;
+
+        if (IsValid(GEngine))
+        {
+            if (const auto& BlueprintTaskEngineSubsystem = GEngine->GetEngineSubsystem<UBtf_EngineSubsystem>();
+                IsValid(BlueprintTaskEngineSubsystem))
+            {
+                BlueprintTaskEngineSubsystem->InvalidateNodeTemplates();
+            }
+        }
     }
 }
 
@@ -871,7 +969,8 @@ void UBtf_ExtendConstructObject_K2Node::PinDefaultValueChanged(UEdGraphPin* Pin)
                 PinName != ClassPinName &&
                 PinName != UEdGraphSchema_K2::PN_Execute &&
                 PinName != UEdGraphSchema_K2::PN_Then &&
-                PinName != NodeGuidStrName)
+                PinName != LoadingPinName &&
+                PinName != NodeGuidPinName)
             {
                 Pins[PinIndex]->MarkAsGarbage();
                 Pins.RemoveAt(PinIndex);
@@ -918,6 +1017,12 @@ void UBtf_ExtendConstructObject_K2Node::AllocateDefaultPins()
     else
     { CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Then); }
 
+    if (LoadClassAsynchronously && FindPin(LoadingPinName) == nullptr)
+    {
+        auto* LoadingPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, LoadingPinName);
+        LoadingPin->PinToolTip = LOCTEXT("LoadingPinTooltip", "Fires when the node runs while its task class is still being loaded").ToString();
+    }
+
     if (IsValid(ProxyClass))
     {
         const auto* K2Schema = GetDefault<UEdGraphSchema_K2>();
@@ -960,10 +1065,10 @@ void UBtf_ExtendConstructObject_K2Node::AllocateDefaultPins()
         }
     }
 
-    if (IsValid(TaskInstance))
+    if (auto* NodeGuidPin = FindPin(NodeGuidPinName);
+        NodeGuidPin != nullptr && IsValid(TaskInstance))
     {
-        FindPin(NodeGuidStrName)->DefaultValue = ProxyClass->GetName() + NodeGuid.ToString();
-        FindPin(NodeGuidStrName)->DefaultTextValue = FText::FromString(ProxyClass->GetName() + NodeGuid.ToString());
+        NodeGuidPin->DefaultValue = NodeGuid.ToString();
     }
 
     auto* Graph = GetGraph();
@@ -976,6 +1081,14 @@ void UBtf_ExtendConstructObject_K2Node::ReallocatePinsDuringReconstruction(TArra
 {
     RestoreSplitPins(OldPins);
 
+    // The factory used to take the node identity as a string, that pin has no counterpart anymore
+    // and would otherwise be kept as an orphan because of its non-default value
+    for (auto* OldPin : OldPins)
+    {
+        if (OldPin->PinName == NodeGuidStrName && OldPin->LinkedTo.IsEmpty())
+        { OldPin->bSavePinIfOrphaned = false; }
+    }
+
     CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute);
     CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Then);
 
@@ -1356,16 +1469,16 @@ void UBtf_ExtendConstructObject_K2Node::GenerateFactoryFunctionPins(UClass* Targ
         const auto Index = Pins.IndexOfByKey(OldPin);
         Pins.RemoveAt(Index, 1, EAllowShrinking::No);
         Pins.Add(OldPin);
+        OldPin->PinType.PinSubCategoryObject = Get_OutputObjectClass(TargetClass);
     }
     else
-    { CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Object, TargetClass, OutPutObjectPinName); }
+    { CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Object, Get_OutputObjectClass(TargetClass), OutPutObjectPinName); }
 }
 
 void UBtf_ExtendConstructObject_K2Node::GenerateSpawnParamPins(UClass* TargetClass)
 {
     PinMetadataMap.Reset();
 
-    const auto* K2Schema = GetDefault<UEdGraphSchema_K2>();
     auto* ClassDefaultObject = TargetClass->GetDefaultObject(true);
 
     for (const auto ParamName : SpawnParam)
@@ -1374,43 +1487,7 @@ void UBtf_ExtendConstructObject_K2Node::GenerateSpawnParamPins(UClass* TargetCla
         {
             if (const auto* Property = TargetClass->FindPropertyByName(ParamName))
             {
-                auto* Pin = CreatePin(EGPD_Input, NAME_None, ParamName);
-                check(Pin);
-                K2Schema->ConvertPropertyToPinType(Property, Pin->PinType);
-
-				if (ClassDefaultObject)
-                {
-                    if (const auto* StructProperty = CastField<FStructProperty>(Property))
-                    {
-	                    if (const uint8* StructData = Property->ContainerPtrToValuePtr<uint8>(ClassDefaultObject))
-                        {
-                            FString DefaultStructValue;
-                            StructProperty->Struct->ExportText(
-                                DefaultStructValue,
-                                StructData,
-                                StructData,
-                                ClassDefaultObject,
-                                PPF_None,
-                                nullptr
-                            );
-                            K2Schema->TrySetDefaultValue(*Pin, DefaultStructValue);
-                        }
-                    }
-                    else if (K2Schema->PinDefaultValueIsEditable(*Pin))
-                    {
-                        FString DefaultValueAsString;
-                        const bool bDefaultValueSet = FBlueprintEditorUtils::PropertyValueToString(
-                            Property,
-                            reinterpret_cast<const uint8*>(ClassDefaultObject),
-                            DefaultValueAsString,
-                            this);
-                        if (bDefaultValueSet)
-                        {
-                            K2Schema->SetPinAutogeneratedDefaultValue(Pin, DefaultValueAsString);
-                        }
-                    }
-                }
-                K2Schema->ConstructBasicPinTooltip(*Pin, Property->GetToolTipText(), Pin->PinToolTip);
+                const auto* Pin = CreateSpawnParamPin(this, Property, ClassDefaultObject);
 
                 if (const auto* MetaDataMap = Property->GetMetaDataMap())
                 {
@@ -1860,7 +1937,15 @@ bool UBtf_ExtendConstructObject_K2Node::CreateProxyObject(FKismetCompilerContext
     }
 
     // Connect execution pin
-    if (NOT CompilerContext.MovePinLinksToIntermediate(
+    if (LoadClassAsynchronously)
+    {
+        if (NOT ConnectAsyncClassLoad(CompilerContext, SourceGraph, OutProxyNode))
+        {
+            CompilerContext.MessageLog.Error(TEXT("ExtendConstructObject: Failed to connect the class loading. @@"), this);
+            return false;
+        }
+    }
+    else if (NOT CompilerContext.MovePinLinksToIntermediate(
             *FindPinChecked(UEdGraphSchema_K2::PN_Execute),
             *OutProxyNode->FindPinChecked(UEdGraphSchema_K2::PN_Execute))
             .CanSafeConnect())
@@ -1886,6 +1971,10 @@ bool UBtf_ExtendConstructObject_K2Node::CreateProxyObject(FKismetCompilerContext
     // Copy input pins
     for (auto* CurrentPin : Pins)
     {
+        // The class of an asynchronously loaded node is connected by ConnectAsyncClassLoad
+        if (LoadClassAsynchronously && CurrentPin->PinName == ClassPinName)
+        { continue; }
+
         if (CurrentPin->PinName != UEdGraphSchema_K2::PSC_Self && FNodeHelper::ValidDataPin(CurrentPin, EGPD_Input))
         {
             if (auto* DestPin = OutProxyNode->FindPin(CurrentPin->PinName))
@@ -1900,7 +1989,43 @@ bool UBtf_ExtendConstructObject_K2Node::CreateProxyObject(FKismetCompilerContext
     }
 
     // Set node guid
-    OutProxyNode->FindPin(NodeGuidStrName)->DefaultValue = NodeGuid.ToString();
+    if (auto* NodeGuidPin = OutProxyNode->FindPin(NodeGuidPinName))
+    {
+        NodeGuidPin->DefaultValue = NodeGuid.ToString();
+    }
+
+    if (auto* ReentrancyPolicyPin = OutProxyNode->FindPin(ReentrancyPolicyPinName))
+    {
+        ReentrancyPolicyPin->DefaultValue = StaticEnum<EBtf_TaskReentrancyPolicy>()->GetNameStringByValue(static_cast<int64>(ReentrancyPolicy));
+    }
+
+    // Bake the instance template into the generated class and hand it to the factory as a literal,
+    // so the runtime does not depend on the Blueprint's extensions to find it
+    if (auto* TemplatePin = OutProxyNode->FindPin(TemplatePinName);
+        TemplatePin != nullptr && AllowInstance && IsValid(TaskInstance) && IsValid(CompilerContext.NewClass))
+    {
+        const auto BakedTemplateName = FName(FString::Printf(TEXT("BtfTemplate_%s"), *NodeGuid.ToString()));
+
+        // A previous compile of this class may have left its copy behind, move it out of the way
+        if (auto* PreviousTemplate = FindObjectFast<UObject>(CompilerContext.NewClass, BakedTemplateName))
+        {
+            PreviousTemplate->Rename(nullptr, GetTransientPackage(), REN_DontCreateRedirectors | REN_DoNotDirty | REN_NonTransactional);
+        }
+
+        auto* BakedTemplate = DuplicateObject<UBtf_TaskForge>(TaskInstance, CompilerContext.NewClass, BakedTemplateName);
+        BakedTemplate->ClearFlags(RF_Transient | RF_Transactional);
+        BakedTemplate->SetFlags(RF_ArchetypeObject);
+
+        auto* LiteralNode = CompilerContext.SpawnIntermediateNode<UK2Node_Literal>(this, SourceGraph);
+        LiteralNode->SetObjectRef(BakedTemplate);
+        LiteralNode->AllocateDefaultPins();
+
+        if (NOT Schema->TryCreateConnection(LiteralNode->GetValuePin(), TemplatePin))
+        {
+            CompilerContext.MessageLog.Error(TEXT("ExtendConstructObject: Failed to connect the instance template. @@"), this);
+            return false;
+        }
+    }
 
     OutProxyPin = OutProxyNode->GetReturnValuePin();
     return true;
@@ -1935,13 +2060,14 @@ UEdGraphPin* UBtf_ExtendConstructObject_K2Node::CastProxyObjectIfNeeded(FKismetC
                                                                        UEdGraph* SourceGraph,
                                                                        UEdGraphPin* ProxyObjectPin)
 {
-    if (ProxyObjectPin->PinType.PinSubCategoryObject.Get() == ProxyClass)
+    auto* TargetClass = Get_OutputObjectClass(ProxyClass);
+    if (ProxyObjectPin->PinType.PinSubCategoryObject.Get() == TargetClass)
     { return ProxyObjectPin; }
 
     const auto* Schema = CompilerContext.GetSchema();
     auto* CastNode = CompilerContext.SpawnIntermediateNode<UK2Node_DynamicCast>(this, SourceGraph);
     CastNode->SetPurity(true);
-    CastNode->TargetType = ProxyClass;
+    CastNode->TargetType = TargetClass;
     CastNode->AllocateDefaultPins();
 
     Schema->TryCreateConnection(ProxyObjectPin, CastNode->GetCastSourcePin());
@@ -1951,6 +2077,95 @@ UEdGraphPin* UBtf_ExtendConstructObject_K2Node::CastProxyObjectIfNeeded(FKismetC
     return CastOutput;
 }
 
+void UBtf_ExtendConstructObject_K2Node::UpdateTaskPreloadManifest(const FKismetCompilerContext& CompilerContext)
+{
+    if (NOT IsValid(CompilerContext.Blueprint) || NOT IsValid(CompilerContext.NewClass))
+    { return; }
+
+    auto TaskClasses = TArray<TSoftClassPtr<UBtf_TaskForge>>{};
+
+    auto TaskNodes = TArray<UBtf_ExtendConstructObject_K2Node*>{};
+    FBlueprintEditorUtils::GetAllNodesOfClass(CompilerContext.Blueprint, TaskNodes);
+    for (const auto* TaskNode : TaskNodes)
+    {
+        if (IsValid(TaskNode->ProxyClass) && TaskNode->ProxyClass->IsChildOf<UBtf_TaskForge>())
+        {
+            TaskClasses.AddUnique(TSoftClassPtr<UBtf_TaskForge>(TaskNode->ProxyClass));
+        }
+    }
+
+    auto BatchNodes = TArray<UBtf_SpawnTaskBatch_K2Node*>{};
+    FBlueprintEditorUtils::GetAllNodesOfClass(CompilerContext.Blueprint, BatchNodes);
+    for (const auto* BatchNode : BatchNodes)
+    {
+        if (IsValid(BatchNode->TaskClass))
+        {
+            TaskClasses.AddUnique(TSoftClassPtr<UBtf_TaskForge>(BatchNode->TaskClass.Get()));
+        }
+    }
+
+    UBtf_TaskPreloadManifest::Set(CompilerContext.NewClass, MoveTemp(TaskClasses));
+}
+
+bool UBtf_ExtendConstructObject_K2Node::ConnectAsyncClassLoad(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph,
+                                                              UK2Node_CallFunction* ProxyNode)
+{
+    const auto* Schema = CompilerContext.GetSchema();
+    const auto ClassPath = FSoftObjectPath(ProxyClass).ToString();
+    auto IsErrorFree = true;
+
+    const auto SpawnTaskClassCall = [&](const FName InFunctionName) -> UK2Node_CallFunction*
+    {
+        auto* CallNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+        CallNode->FunctionReference.SetExternalMember(InFunctionName, UBtf_TaskForge::StaticClass());
+        CallNode->AllocateDefaultPins();
+        CallNode->FindPinChecked(ClassPinName)->DefaultValue = ClassPath;
+        return CallNode;
+    };
+
+    // The factory gets the loaded class, the compiled graph only keeps its path
+    auto* ResolveClassNode = SpawnTaskClassCall(GET_FUNCTION_NAME_CHECKED(UBtf_TaskForge, ResolveTaskClass));
+    IsErrorFree &= Schema->TryCreateConnection(ResolveClassNode->GetReturnValuePin(), ProxyNode->FindPinChecked(ClassPinName));
+
+    // Already loaded: spawn right away, without waiting for the latent action
+    auto* IsLoadedNode = SpawnTaskClassCall(GET_FUNCTION_NAME_CHECKED(UBtf_TaskForge, IsTaskClassLoaded));
+    auto* BranchNode = CompilerContext.SpawnIntermediateNode<UK2Node_IfThenElse>(this, SourceGraph);
+    BranchNode->AllocateDefaultPins();
+
+    IsErrorFree &= CompilerContext.MovePinLinksToIntermediate(*FindPinChecked(UEdGraphSchema_K2::PN_Execute), *BranchNode->GetExecPin()).CanSafeConnect();
+    IsErrorFree &= Schema->TryCreateConnection(IsLoadedNode->GetReturnValuePin(), BranchNode->GetConditionPin());
+    IsErrorFree &= Schema->TryCreateConnection(BranchNode->GetThenPin(), ProxyNode->GetExecPin());
+
+    // Not loaded: fire "Loading", then spawn once the class is streamed in
+    auto* SequenceNode = CompilerContext.SpawnIntermediateNode<UK2Node_ExecutionSequence>(this, SourceGraph);
+    SequenceNode->AllocateDefaultPins();
+    IsErrorFree &= Schema->TryCreateConnection(BranchNode->GetElsePin(), SequenceNode->GetExecPin());
+
+    if (auto* LoadingPin = FindPin(LoadingPinName, EGPD_Output))
+    {
+        IsErrorFree &= CompilerContext.MovePinLinksToIntermediate(*LoadingPin, *SequenceNode->GetThenPinGivenIndex(0)).CanSafeConnect();
+    }
+
+    auto* LoadClassNode = SpawnTaskClassCall(GET_FUNCTION_NAME_CHECKED(UBtf_TaskForge, LoadTaskClass));
+    IsErrorFree &= Schema->TryCreateConnection(SequenceNode->GetThenPinGivenIndex(1), LoadClassNode->GetExecPin());
+    IsErrorFree &= Schema->TryCreateConnection(LoadClassNode->GetThenPin(), ProxyNode->GetExecPin());
+
+    return IsErrorFree;
+}
+
+UClass* UBtf_ExtendConstructObject_K2Node::Get_OutputObjectClass(UClass* TargetClass) const
+{
+    if (NOT LoadClassAsynchronously || NOT IsValid(TargetClass))
+    { return TargetClass; }
+
+    return FBlueprintEditorUtils::FindFirstNativeClass(TargetClass);
+}
+
+bool UBtf_ExtendConstructObject_K2Node::IsReferencedByPath(const UClass* OwnerClass) const
+{
+    return LoadClassAsynchronously && IsValid(OwnerClass) && NOT OwnerClass->HasAnyClassFlags(CLASS_Native);
+}
+
 TArray<UBtf_ExtendConstructObject_K2Node::FNodeHelper::FOutputPinAndLocalVariable>
 UBtf_ExtendConstructObject_K2Node::CreateVariableOutputs(FKismetCompilerContext& CompilerContext)
 {
@@ -2090,7 +2305,8 @@ bool UBtf_ExtendConstructObject_K2Node::ProcessOutputDelegates(FKismetCompilerCo
             LastThenPin,
             this,
             SourceGraph,
-            CompilerContext);
+            CompilerContext,
+            IsReferencedByPath(DelegateProperty->GetOwnerClass()));
 
         if (NOT Success)
         {
@@ -2154,7 +2370,7 @@ bool UBtf_ExtendConstructObject_K2Node::ProcessAutoCallFunctions(FKismetCompiler
         }
 
         auto* CallFunctionNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
-        CallFunctionNode->FunctionReference.SetExternalMember(FunctionName, ProxyClass);
+        CallFunctionNode->FunctionReference.SetExternalMember(FunctionName, LoadClassAsynchronously ? TargetFunction->GetOwnerClass() : ProxyClass);
         CallFunctionNode->AllocateDefaultPins();
 
         auto* ActivateCallSelfPin = Schema->FindSelfPin(*CallFunctionNode, EGPD_Input);
@@ -2249,8 +2465,8 @@ bool UBtf_ExtendConstructObject_K2Node::ProcessExecFunctions(FKismetCompilerCont
         if (FunctionName == NAME_None)
         { continue; }
 
-        if (const auto* TargetFunction = ProxyClass->FindFunctionByName(FunctionName);
-            NOT TargetFunction)
+        const auto* TargetFunction = ProxyClass->FindFunctionByName(FunctionName);
+        if (NOT TargetFunction)
         {
             CompilerContext.MessageLog.Error(TEXT("ExtendConstructObject: Need Refresh Node. @@"), this);
             continue;
@@ -2273,7 +2489,7 @@ bool UBtf_ExtendConstructObject_K2Node::ProcessExecFunctions(FKismetCompilerCont
 
         // Create function call
         auto* CallFunctionNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
-        CallFunctionNode->FunctionReference.SetExternalMember(FunctionName, ProxyClass);
+        CallFunctionNode->FunctionReference.SetExternalMember(FunctionName, LoadClassAsynchronously ? TargetFunction->GetOwnerClass() : ProxyClass);
         CallFunctionNode->AllocateDefaultPins();
 
         if (CallFunctionNode->IsNodePure())
@@ -2329,43 +2545,33 @@ bool UBtf_ExtendConstructObject_K2Node::ConnectSpawnProperties(
     UEdGraphPin* SpawnedActorReturnPin)
 {
     auto IsErrorFree = true;
+
+    // Connected spawn params are applied together by a single ApplySpawnParams call, the remaining
+    // literal values are set one by one below since their defaults are checked against the class defaults
+    auto PackedSpawnVarPins = TArray<UEdGraphPin*>{};
+    for (const auto& PinParamName : SpawnParam)
+    {
+        if (auto* SpawnVarPin = FindPin(PinParamName);
+            SpawnVarPin != nullptr && SpawnVarPin->LinkedTo.Num() > 0)
+        {
+            PackedSpawnVarPins.Add(SpawnVarPin);
+        }
+    }
+
+    if (NOT PackedSpawnVarPins.IsEmpty())
+    {
+        IsErrorFree &= ConnectPackedSpawnProperties(this, PackedSpawnVarPins, Schema, CompilerContext, SourceGraph, LastThenPin, SpawnedActorReturnPin);
+    }
+
     for (const auto OldPinParamName : SpawnParam)
     {
         auto* SpawnVarPin = FindPin(OldPinParamName);
 
-        if (NOT SpawnVarPin)
+        if (NOT SpawnVarPin || PackedSpawnVarPins.Contains(SpawnVarPin))
         { continue; }
 
-        const auto HasDefaultValue = NOT SpawnVarPin->DefaultValue.IsEmpty() || NOT SpawnVarPin->DefaultTextValue.IsEmpty() || IsValid(SpawnVarPin->DefaultObject);
-        if (SpawnVarPin->LinkedTo.Num() > 0 || HasDefaultValue)
+        if (SpawnVarPin->LinkedTo.Num() > 0 || NOT IsSpawnParamPinAtClassDefault(SpawnVarPin, ClassToSpawn, this))
         {
-            if (SpawnVarPin->LinkedTo.Num() == 0)
-            {
-                const FProperty* Property = FindFProperty<FProperty>(ClassToSpawn, SpawnVarPin->PinName);
-                if (!Property) continue;
-
-                if (ClassToSpawn->GetDefaultObject() != nullptr)
-                {
-                    FString DefaultValueAsString;
-                    FBlueprintEditorUtils::PropertyValueToString(
-                        Property,
-                        reinterpret_cast<uint8*>(ClassToSpawn->GetDefaultObject()),
-                        DefaultValueAsString,
-                        this);
-
-                    // Text is stored as DefaultTextValue, not entirely sure why
-                    if (SpawnVarPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Text)
-                    {
-                        if (SpawnVarPin->DefaultTextValue.EqualTo(FText::FromString(DefaultValueAsString)))
-                            continue;
-                    }
-                    else if (DefaultValueAsString == SpawnVarPin->DefaultValue)
-                    {
-                        continue;
-                    }
-                }
-            }
-
             if (const auto* SetByNameFunction = Schema->FindSetVariableByNameFunction(SpawnVarPin->PinType))
             {
                 auto* SetVarNode = SpawnVarPin->PinType.IsArray()
@@ -2432,6 +2638,152 @@ bool UBtf_ExtendConstructObject_K2Node::ConnectSpawnProperties(
     return IsErrorFree;
 }
 
+bool UBtf_ExtendConstructObject_K2Node::ConnectPackedSpawnProperties(
+    UK2Node* OwningNode,
+    const TArray<UEdGraphPin*>& SpawnVarPins,
+    const UEdGraphSchema_K2* Schema,
+    FKismetCompilerContext& CompilerContext,
+    UEdGraph* SourceGraph,
+    UEdGraphPin*& LastThenPin,
+    UEdGraphPin* SpawnedActorReturnPin)
+{
+    auto* ApplyNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(OwningNode, SourceGraph);
+    ApplyNode->FunctionReference.SetExternalMember(
+        GET_FUNCTION_NAME_CHECKED(UBtf_ExtendConstructObject_Utils, ApplySpawnParams),
+        UBtf_ExtendConstructObject_Utils::StaticClass());
+    ApplyNode->AllocateDefaultPins();
+
+    static const auto ObjectParamName = FName(TEXT("Object"));
+    static const auto PropertyNamesParamName = FName(TEXT("PropertyNames"));
+
+    auto IsErrorFree = Schema->TryCreateConnection(LastThenPin, ApplyNode->GetExecPin());
+    IsErrorFree &= Schema->TryCreateConnection(SpawnedActorReturnPin, ApplyNode->FindPinChecked(ObjectParamName));
+
+    // The property names are passed as an array literal, their order matches the values passed after it
+    IsErrorFree &= ConnectSpawnParamNames(
+        OwningNode, SpawnVarPins, ApplyNode->FindPinChecked(PropertyNamesParamName), Schema, CompilerContext, SourceGraph);
+
+    for (auto Index = 0; Index < SpawnVarPins.Num(); ++Index)
+    {
+        auto* SpawnVarPin = SpawnVarPins[Index];
+        auto* ValuePin = ApplyNode->CreatePin(EGPD_Input, SpawnVarPin->PinType, FName(TEXT("Value"), Index + 1));
+        IsErrorFree &= CompilerContext.MovePinLinksToIntermediate(*SpawnVarPin, *ValuePin).CanSafeConnect();
+    }
+
+    if (NOT IsErrorFree)
+    {
+        CompilerContext.MessageLog.Error(
+            *LOCTEXT("InternalConnectionError", "ExtendConstructObject: Internal connection error. @@").ToString(),
+            OwningNode);
+    }
+
+    LastThenPin = ApplyNode->GetThenPin();
+    return IsErrorFree;
+}
+
+bool UBtf_ExtendConstructObject_K2Node::ConnectSpawnParamNames(
+    UK2Node* OwningNode,
+    const TArray<UEdGraphPin*>& SpawnVarPins,
+    UEdGraphPin* NamesPin,
+    const UEdGraphSchema_K2* Schema,
+    FKismetCompilerContext& CompilerContext,
+    UEdGraph* SourceGraph)
+{
+    auto* MakeArrayNode = CompilerContext.SpawnIntermediateNode<UK2Node_MakeArray>(OwningNode, SourceGraph);
+    MakeArrayNode->AllocateDefaultPins();
+    for (auto Index = 1; Index < SpawnVarPins.Num(); ++Index)
+    {
+        MakeArrayNode->AddInputPin();
+    }
+
+    auto* ArrayOutputPin = MakeArrayNode->GetOutputPin();
+    const auto IsErrorFree = Schema->TryCreateConnection(ArrayOutputPin, NamesPin);
+    MakeArrayNode->PinConnectionListChanged(ArrayOutputPin);
+
+    auto NameIndex = 0;
+    for (auto* ArrayInputPin : MakeArrayNode->Pins)
+    {
+        if (ArrayInputPin->Direction == EGPD_Input && SpawnVarPins.IsValidIndex(NameIndex))
+        {
+            ArrayInputPin->DefaultValue = SpawnVarPins[NameIndex++]->PinName.ToString();
+        }
+    }
+
+    return IsErrorFree;
+}
+
+UEdGraphPin* UBtf_ExtendConstructObject_K2Node::CreateSpawnParamPin(UK2Node* OwningNode, const FProperty* Property, UObject* ClassDefaultObject)
+{
+    const auto* K2Schema = GetDefault<UEdGraphSchema_K2>();
+
+    auto* Pin = OwningNode->CreatePin(EGPD_Input, NAME_None, Property->GetFName());
+    check(Pin);
+    K2Schema->ConvertPropertyToPinType(Property, Pin->PinType);
+
+    if (ClassDefaultObject)
+    {
+        if (const auto* StructProperty = CastField<FStructProperty>(Property))
+        {
+            if (const uint8* StructData = Property->ContainerPtrToValuePtr<uint8>(ClassDefaultObject))
+            {
+                FString DefaultStructValue;
+                StructProperty->Struct->ExportText(
+                    DefaultStructValue,
+                    StructData,
+                    StructData,
+                    ClassDefaultObject,
+                    PPF_None,
+                    nullptr
+                );
+                K2Schema->TrySetDefaultValue(*Pin, DefaultStructValue);
+            }
+        }
+        else if (K2Schema->PinDefaultValueIsEditable(*Pin))
+        {
+            FString DefaultValueAsString;
+            const bool bDefaultValueSet = FBlueprintEditorUtils::PropertyValueToString(
+                Property,
+                reinterpret_cast<const uint8*>(ClassDefaultObject),
+                DefaultValueAsString,
+                OwningNode);
+            if (bDefaultValueSet)
+            {
+                K2Schema->SetPinAutogeneratedDefaultValue(Pin, DefaultValueAsString);
+            }
+        }
+    }
+    K2Schema->ConstructBasicPinTooltip(*Pin, Property->GetToolTipText(), Pin->PinToolTip);
+
+    return Pin;
+}
+
+bool UBtf_ExtendConstructObject_K2Node::IsSpawnParamPinAtClassDefault(const UEdGraphPin* SpawnVarPin, const UClass* ClassToSpawn, UK2Node* OwningNode)
+{
+    const auto HasDefaultValue = NOT SpawnVarPin->DefaultValue.IsEmpty() || NOT SpawnVarPin->DefaultTextValue.IsEmpty() || IsValid(SpawnVarPin->DefaultObject);
+    if (NOT HasDefaultValue)
+    { return true; }
+
+    const auto* Property = FindFProperty<FProperty>(ClassToSpawn, SpawnVarPin->PinName);
+    if (Property == nullptr)
+    { return true; }
+
+    if (ClassToSpawn->GetDefaultObject() == nullptr)
+    { return false; }
+
+    FString DefaultValueAsString;
+    FBlueprintEditorUtils::PropertyValueToString(
+        Property,
+        reinterpret_cast<uint8*>(ClassToSpawn->GetDefaultObject()),
+        DefaultValueAsString,
+        OwningNode);
+
+    // Text is stored as DefaultTextValue, not entirely sure why
+    if (SpawnVarPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Text)
+    { return SpawnVarPin->DefaultTextValue.EqualTo(FText::FromString(DefaultValueAsString)); }
+
+    return DefaultValueAsString == SpawnVarPin->DefaultValue;
+}
+
 bool UBtf_ExtendConstructObject_K2Node::FNodeHelper::ValidDataPin(const UEdGraphPin* Pin, EEdGraphPinDirection Direction)
 {
     const auto ValidDataPin = Pin &&
@@ -2491,7 +2843,8 @@ bool UBtf_ExtendConstructObject_K2Node::FNodeHelper::HandleDelegateImplementatio
     UEdGraphPin*& InOutLastThenPin,
     UK2Node* CurrentNode,
     UEdGraph* SourceGraph,
-    FKismetCompilerContext& CompilerContext)
+    FKismetCompilerContext& CompilerContext,
+    const bool BindByName)
 {
     auto IsErrorFree = true;
     const auto* Schema = CompilerContext.GetSchema();
@@ -2508,6 +2861,31 @@ bool UBtf_ExtendConstructObject_K2Node::FNodeHelper::HandleDelegateImplementatio
     }
 
     auto* CurrentCeNode = CompilerContext.SpawnIntermediateNode<UK2Node_CustomEvent>(CurrentNode, SourceGraph);
+    if (BindByName)
+    {
+        // The delegate is looked up on the spawned task, only its name and the event's name end up in the graph
+        CurrentCeNode->CustomFunctionName = *FString::Printf(TEXT("%s_%s"), *CurrentProperty->GetName(), *CompilerContext.GetGuid(CurrentNode));
+        CurrentCeNode->AllocateDefaultPins();
+        IsErrorFree &= FNodeHelper::CopyEventSignature(CurrentCeNode, CurrentProperty->SignatureFunction, Schema);
+
+        auto* BindNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(CurrentNode, SourceGraph);
+        BindNode->FunctionReference.SetExternalMember(
+            GET_FUNCTION_NAME_CHECKED(UBtf_ExtendConstructObject_Utils, BindDelegateByName),
+            UBtf_ExtendConstructObject_Utils::StaticClass());
+        BindNode->AllocateDefaultPins();
+
+        auto* SelfNode = CompilerContext.SpawnIntermediateNode<UK2Node_Self>(CurrentNode, SourceGraph);
+        SelfNode->AllocateDefaultPins();
+
+        IsErrorFree &= Schema->TryCreateConnection(InOutLastThenPin, BindNode->GetExecPin());
+        IsErrorFree &= Schema->TryCreateConnection(ProxyObjectPin, BindNode->FindPinChecked(TEXT("Object")));
+        IsErrorFree &= Schema->TryCreateConnection(SelfNode->FindPinChecked(UEdGraphSchema_K2::PN_Self), BindNode->FindPinChecked(TEXT("Listener")));
+        BindNode->FindPinChecked(TEXT("DelegateName"))->DefaultValue = CurrentProperty->GetName();
+        BindNode->FindPinChecked(TEXT("FunctionName"))->DefaultValue = CurrentCeNode->CustomFunctionName.ToString();
+
+        InOutLastThenPin = BindNode->GetThenPin();
+    }
+    else
     {
         auto* AddDelegateNode = CompilerContext.SpawnIntermediateNode<UK2Node_AddDelegate>(CurrentNode, SourceGraph);
         AddDelegateNode->SetFromProperty(CurrentProperty, false, CurrentProperty->GetOwnerClass());
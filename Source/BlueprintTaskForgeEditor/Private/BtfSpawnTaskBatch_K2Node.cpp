@@ -0,0 +1,300 @@
+// Copyright (c) 2025 BlueprintTaskForge Maintainers
+//
+// This file is part of the BlueprintTaskForge Plugin for Unreal Engine.
+//
+// Licensed under the BlueprintTaskForge Open Plugin License v1.0 (BTFPL-1.0).
+// You may obtain a copy of the license at:
+// https://github.com/CommitAndChill/BlueprintTaskForge/blob/main/LICENSE.md
+//
+// SPDX-License-Identifier: BTFPL-1.0
+
+#include "BtfSpawnTaskBatch_K2Node.h"
+
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "BlueprintNodeSpawner.h"
+#include "BtfExtendConstructObject_K2Node.h"
+#include "EdGraphSchema_K2.h"
+#include "GraphEditorSettings.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_Literal.h"
+#include "K2Node_Self.h"
+#include "KismetCompiler.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+
+// --------------------------------------------------------------------------------------------------------------------
+
+#define LOCTEXT_NAMESPACE "K2Node"
+
+const FName UBtf_SpawnTaskBatch_K2Node::PN_Outers = TEXT("Outers");
+const FName UBtf_SpawnTaskBatch_K2Node::PN_CountPerOuter = TEXT("CountPerOuter");
+const FName UBtf_SpawnTaskBatch_K2Node::PN_ActivateTasks = TEXT("ActivateTasks");
+const FName UBtf_SpawnTaskBatch_K2Node::PN_Tasks = TEXT("Tasks");
+
+UBtf_SpawnTaskBatch_K2Node::UBtf_SpawnTaskBatch_K2Node(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+}
+
+void UBtf_SpawnTaskBatch_K2Node::AllocateDefaultPins()
+{
+    CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute);
+    CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Then);
+
+    const auto* K2Schema = GetDefault<UEdGraphSchema_K2>();
+
+    auto ArrayPinParams = FCreatePinParams{};
+    ArrayPinParams.ContainerType = EPinContainerType::Array;
+
+    CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Object, UObject::StaticClass(), PN_Outers, ArrayPinParams);
+
+    auto* CountPerOuterPin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Int, PN_CountPerOuter);
+    K2Schema->SetPinAutogeneratedDefaultValue(CountPerOuterPin, TEXT("1"));
+
+    auto* ActivateTasksPin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Boolean, PN_ActivateTasks);
+    K2Schema->SetPinAutogeneratedDefaultValue(ActivateTasksPin, TEXT("true"));
+
+    CreateSpawnParamPins();
+
+    const auto OutputClass = IsValid(TaskClass) ? TaskClass.Get() : UBtf_TaskForge::StaticClass();
+    CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Object, OutputClass, PN_Tasks, ArrayPinParams);
+
+    Super::AllocateDefaultPins();
+}
+
+FText UBtf_SpawnTaskBatch_K2Node::GetTooltipText() const
+{
+    return LOCTEXT("NodeTooltip", "Spawns the same task for every outer in one batch, sharing the spawn params between all of them");
+}
+
+FText UBtf_SpawnTaskBatch_K2Node::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+    if (NOT IsValid(TaskClass))
+    {
+        return LOCTEXT("NodeTitle_NoClass", "Spawn Task Batch (None Selected)");
+    }
+
+    return FText::Format(LOCTEXT("NodeTitle", "Spawn Task Batch: {0}"), TaskClass->GetDisplayNameText());
+}
+
+FSlateIcon UBtf_SpawnTaskBatch_K2Node::GetIconAndTint(FLinearColor& OutColor) const
+{
+    OutColor = GetDefault<UGraphEditorSettings>()->FunctionCallNodeTitleColor;
+    return FSlateIcon(FAppStyle::GetAppStyleSetName(), TEXT("Kismet.AllClasses.FunctionIcon"));
+}
+
+void UBtf_SpawnTaskBatch_K2Node::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UBtf_SpawnTaskBatch_K2Node, TaskClass))
+    {
+        ReconstructNode();
+        GetGraph()->NotifyGraphChanged();
+    }
+}
+
+FText UBtf_SpawnTaskBatch_K2Node::GetMenuCategory() const
+{
+    return LOCTEXT("MenuCategory", "Blueprint Task Forge");
+}
+
+void UBtf_SpawnTaskBatch_K2Node::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+    const auto ActionKey = GetClass();
+    if (NOT ActionRegistrar.IsOpenForRegistration(ActionKey))
+    { return; }
+
+    if (auto* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass()))
+    {
+        ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+    }
+}
+
+void UBtf_SpawnTaskBatch_K2Node::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+    Super::ExpandNode(CompilerContext, SourceGraph);
+
+    if (NOT IsValid(TaskClass) || NOT IsValid(CompilerContext.NewClass))
+    {
+        BreakAllNodeLinks();
+        return;
+    }
+
+    const auto* Schema = CompilerContext.GetSchema();
+    auto IsErrorFree = true;
+
+    // Literal spawn params are constant, they are baked into a params template owned by the generated class
+    // while connected ones are applied at runtime on a copy of it kept by the node's owner
+    auto* BakedParams = static_cast<UBtf_TaskForge*>(nullptr);
+    auto LinkedSpawnParamPins = TArray<UEdGraphPin*>{};
+    for (auto* SpawnParamPin : GetSpawnParamPins())
+    {
+        if (SpawnParamPin->LinkedTo.Num() > 0)
+        {
+            LinkedSpawnParamPins.Add(SpawnParamPin);
+            continue;
+        }
+
+        if (UBtf_ExtendConstructObject_K2Node::IsSpawnParamPinAtClassDefault(SpawnParamPin, TaskClass, this))
+        { continue; }
+
+        const auto* Property = TaskClass->FindPropertyByName(SpawnParamPin->PinName);
+        if (Property == nullptr)
+        { continue; }
+
+        if (BakedParams == nullptr)
+        {
+            const auto BakedParamsName = FName(FString::Printf(TEXT("BtfBatchParams_%s"), *NodeGuid.ToString()));
+
+            // A previous compile of this class may have left its copy behind, move it out of the way
+            if (auto* PreviousParams = FindObjectFast<UObject>(CompilerContext.NewClass, BakedParamsName))
+            {
+                PreviousParams->Rename(nullptr, GetTransientPackage(), REN_DontCreateRedirectors | REN_DoNotDirty | REN_NonTransactional);
+            }
+
+            BakedParams = NewObject<UBtf_TaskForge>(CompilerContext.NewClass, TaskClass, BakedParamsName, RF_ArchetypeObject);
+        }
+
+        FBlueprintEditorUtils::PropertyValueFromString(Property, SpawnParamPin->GetDefaultAsString(), reinterpret_cast<uint8*>(BakedParams), this);
+    }
+
+    auto* SpawnBatchNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+    SpawnBatchNode->FunctionReference.SetExternalMember(
+        GET_FUNCTION_NAME_CHECKED(UBtf_TaskForge, SpawnTaskBatch),
+        UBtf_TaskForge::StaticClass());
+    SpawnBatchNode->AllocateDefaultPins();
+
+    static const auto ClassParamName = FName(TEXT("Class"));
+    static const auto SharedParamsParamName = FName(TEXT("SharedParams"));
+    static const auto TemplateParamName = FName(TEXT("Template"));
+    static const auto OwnerParamName = FName(TEXT("Owner"));
+    static const auto ParamsNameParamName = FName(TEXT("ParamsName"));
+    static const auto SpawnParamNamesParamName = FName(TEXT("SpawnParamNames"));
+
+    SpawnBatchNode->FindPinChecked(ClassParamName)->DefaultObject = TaskClass;
+
+    auto* SharedParamsPin = static_cast<UEdGraphPin*>(nullptr);
+    if (IsValid(BakedParams))
+    {
+        auto* LiteralNode = CompilerContext.SpawnIntermediateNode<UK2Node_Literal>(this, SourceGraph);
+        LiteralNode->SetObjectRef(BakedParams);
+        LiteralNode->AllocateDefaultPins();
+        SharedParamsPin = LiteralNode->GetValuePin();
+    }
+
+    auto* LastThenPin = static_cast<UEdGraphPin*>(nullptr);
+    if (NOT LinkedSpawnParamPins.IsEmpty())
+    {
+        auto* MakeParamsNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+        MakeParamsNode->FunctionReference.SetExternalMember(
+            GET_FUNCTION_NAME_CHECKED(UBtf_TaskForge, MakeTaskBatchParams),
+            UBtf_TaskForge::StaticClass());
+        MakeParamsNode->AllocateDefaultPins();
+        MakeParamsNode->FindPinChecked(ClassParamName)->DefaultObject = TaskClass;
+        MakeParamsNode->FindPinChecked(ParamsNameParamName)->DefaultValue =
+            FString::Printf(TEXT("BtfBatchRuntimeParams_%s"), *NodeGuid.ToString());
+
+        // The params are kept by the object running the graph and reused by every execution of the node
+        auto* SelfNode = CompilerContext.SpawnIntermediateNode<UK2Node_Self>(this, SourceGraph);
+        SelfNode->AllocateDefaultPins();
+        IsErrorFree &= Schema->TryCreateConnection(SelfNode->FindPinChecked(UEdGraphSchema_K2::PN_Self), MakeParamsNode->FindPinChecked(OwnerParamName));
+
+        IsErrorFree &= UBtf_ExtendConstructObject_K2Node::ConnectSpawnParamNames(
+            this, LinkedSpawnParamPins, MakeParamsNode->FindPinChecked(SpawnParamNamesParamName), Schema, CompilerContext, SourceGraph);
+
+        if (SharedParamsPin != nullptr)
+        {
+            IsErrorFree &= Schema->TryCreateConnection(SharedParamsPin, MakeParamsNode->FindPinChecked(TemplateParamName));
+        }
+
+        IsErrorFree &= CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *MakeParamsNode->GetExecPin()).CanSafeConnect();
+        LastThenPin = MakeParamsNode->GetThenPin();
+        SharedParamsPin = MakeParamsNode->GetReturnValuePin();
+
+        IsErrorFree &= UBtf_ExtendConstructObject_K2Node::ConnectPackedSpawnProperties(
+            this, LinkedSpawnParamPins, Schema, CompilerContext, SourceGraph, LastThenPin, SharedParamsPin);
+
+        IsErrorFree &= Schema->TryCreateConnection(LastThenPin, SpawnBatchNode->GetExecPin());
+    }
+    else
+    {
+        IsErrorFree &= CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *SpawnBatchNode->GetExecPin()).CanSafeConnect();
+    }
+
+    if (SharedParamsPin != nullptr)
+    {
+        IsErrorFree &= Schema->TryCreateConnection(SharedParamsPin, SpawnBatchNode->FindPinChecked(SharedParamsParamName));
+    }
+
+    IsErrorFree &= CompilerContext.MovePinLinksToIntermediate(*FindPinChecked(PN_Outers), *SpawnBatchNode->FindPinChecked(PN_Outers)).CanSafeConnect();
+    IsErrorFree &= CompilerContext.MovePinLinksToIntermediate(*FindPinChecked(PN_CountPerOuter), *SpawnBatchNode->FindPinChecked(PN_CountPerOuter)).CanSafeConnect();
+    IsErrorFree &= CompilerContext.MovePinLinksToIntermediate(*FindPinChecked(PN_ActivateTasks), *SpawnBatchNode->FindPinChecked(PN_ActivateTasks)).CanSafeConnect();
+
+    // Copy the type so the returned array uses the selected task class
+    auto* TasksPin = FindPinChecked(PN_Tasks);
+    auto* ReturnValuePin = SpawnBatchNode->GetReturnValuePin();
+    ReturnValuePin->PinType = TasksPin->PinType;
+    IsErrorFree &= CompilerContext.MovePinLinksToIntermediate(*TasksPin, *ReturnValuePin).CanSafeConnect();
+
+    IsErrorFree &= CompilerContext.MovePinLinksToIntermediate(*FindPinChecked(UEdGraphSchema_K2::PN_Then), *SpawnBatchNode->GetThenPin()).CanSafeConnect();
+
+    if (NOT IsErrorFree)
+    {
+        CompilerContext.MessageLog.Error(*LOCTEXT("InternalConnectionError", "SpawnTaskBatch: Internal connection error. @@").ToString(), this);
+    }
+
+    BreakAllNodeLinks();
+}
+
+void UBtf_SpawnTaskBatch_K2Node::EarlyValidation(FCompilerResultsLog& MessageLog) const
+{
+    Super::EarlyValidation(MessageLog);
+
+    if (NOT IsValid(TaskClass))
+    {
+        MessageLog.Error(*LOCTEXT("NoTaskClassSelected", "No task class selected in @@").ToString(), this);
+    }
+    else if (TaskClass->HasAnyClassFlags(CLASS_Abstract))
+    {
+        MessageLog.Error(*LOCTEXT("AbstractTaskClass", "Abstract task class selected in @@").ToString(), this);
+    }
+}
+
+void UBtf_SpawnTaskBatch_K2Node::CreateSpawnParamPins()
+{
+    if (NOT IsValid(TaskClass))
+    { return; }
+
+    auto* TaskCDO = TaskClass->GetDefaultObject<UBtf_TaskForge>();
+    if (NOT IsValid(TaskCDO))
+    { return; }
+
+    for (const auto& SpawnParam : TaskCDO->SpawnParam)
+    {
+        const auto* Property = TaskClass->FindPropertyByName(SpawnParam.Name);
+        if (Property == nullptr || FindPin(Property->GetFName()) != nullptr)
+        { continue; }
+
+        UBtf_ExtendConstructObject_K2Node::CreateSpawnParamPin(this, Property, TaskCDO);
+    }
+}
+
+TArray<UEdGraphPin*> UBtf_SpawnTaskBatch_K2Node::GetSpawnParamPins() const
+{
+    auto SpawnParamPins = TArray<UEdGraphPin*>{};
+    for (auto* Pin : Pins)
+    {
+        if (Pin->Direction != EGPD_Input || Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec)
+        { continue; }
+
+        if (Pin->PinName == PN_Outers || Pin->PinName == PN_CountPerOuter || Pin->PinName == PN_ActivateTasks)
+        { continue; }
+
+        SpawnParamPins.Add(Pin);
+    }
+    return SpawnParamPins;
+}
+
+#undef LOCTEXT_NAMESPACE
+
+// --------------------------------------------------------------------------------------------------------------------
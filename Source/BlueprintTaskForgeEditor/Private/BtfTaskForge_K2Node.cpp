@@ -152,10 +152,6 @@ void UBtf_TaskForge_K2Node::AllocateDefaultPins()
     check(GetWorldContextPin());
     HideClassPin();
 
-    FindPin(NodeGuidStrName)->DefaultValue = ProxyClass->GetName() + NodeGuid.ToString();
-    FindPin(NodeGuidStrName)->bHidden = true;
-    FindPin(NodeGuidStrName)->Modify();
-
     UK2Node::AllocateDefaultPins();
     GetGraph()->NotifyGraphChanged();
     FBlueprintEditorUtils::MarkBlueprintAsModified(GetBlueprint());
@@ -255,13 +251,13 @@ FString UBtf_TaskForge_K2Node::Get_NodeDescription() const
     {
         if (IsValid(TaskInstance))
         {
-            return TaskInstance->Get_NodeDescription();
+            return TaskInstance->Query_NodeDescription();
         }
 
         if (const auto& TaskCDO = GetDefault<UBtf_TaskForge>(ProxyClass);
             IsValid(TaskCDO))
         {
-            const auto& NodeDescription = TaskCDO->Get_NodeDescription();
+            const auto& NodeDescription = TaskCDO->Query_NodeDescription();
             return NodeDescription;
         }
 
@@ -281,7 +277,7 @@ FString UBtf_TaskForge_K2Node::Get_NodeDescription() const
           if (const auto FoundTaskInstance = Subsystem->FindTaskInstanceWithGuid(NodeGuid);
               IsValid(FoundTaskInstance))
           {
-              const auto& NodeDescription = FoundTaskInstance->Get_NodeDescription();
+              const auto& NodeDescription = FoundTaskInstance->Query_NodeDescription();
               return NodeDescription;
           }
       }
@@ -301,7 +297,15 @@ FString UBtf_TaskForge_K2Node::Get_StatusString() const
             if (NOT FoundTaskInstance->Get_IsActive())
             { return {}; }
 
-            const auto& NodeStatus = FoundTaskInstance->Get_StatusString();
+            const auto& NodeStatus = FoundTaskInstance->Query_StatusString();
+
+            // Tells which of the tasks running from this node the status belongs to
+            if (GetDefault<UBtf_RuntimeSettings>()->TaskNamingMode == EBtf_TaskNamingMode::DebugNames)
+            {
+                const auto DebugName = FoundTaskInstance->GetDetailedInfo();
+                return NodeStatus.IsEmpty() ? DebugName : FString::Printf(TEXT("%s\n%s"), *DebugName, *NodeStatus);
+            }
+
             return NodeStatus;
         }
     }
@@ -316,7 +320,7 @@ FLinearColor UBtf_TaskForge_K2Node::Get_StatusBackgroundColor() const
     {
         if (IsValid(TaskInstance))
         {
-            if (TaskInstance->Get_StatusBackgroundColor(ObtainedColor))
+            if (TaskInstance->Query_StatusBackgroundColor(ObtainedColor))
             {
                 return ObtainedColor;
             }
@@ -325,7 +329,7 @@ FLinearColor UBtf_TaskForge_K2Node::Get_StatusBackgroundColor() const
         if (const auto& TaskCDO = GetDefault<UBtf_TaskForge>(ProxyClass);
             IsValid(TaskCDO))
         {
-            if (TaskCDO->Get_StatusBackgroundColor(ObtainedColor))
+            if (TaskCDO->Query_StatusBackgroundColor(ObtainedColor))
             {
                 return ObtainedColor;
             }
@@ -340,7 +344,7 @@ FLinearColor UBtf_TaskForge_K2Node::Get_StatusBackgroundColor() const
         if (const auto FoundTaskInstance = Subsystem->FindTaskInstanceWithGuid(NodeGuid);
             IsValid(FoundTaskInstance))
         {
-            if (FoundTaskInstance->Get_StatusBackgroundColor(ObtainedColor))
+            if (FoundTaskInstance->Query_StatusBackgroundColor(ObtainedColor))
             {
                 return ObtainedColor;
             }
@@ -372,7 +376,9 @@ FText UBtf_TaskForge_K2Node::Get_NodeConfigText() const
 TSet<FName> UBtf_TaskForge_K2Node::Get_PinsHiddenByDefault()
 {
     auto PinsHiddenByDefault = TSet{Super::Get_PinsHiddenByDefault()};
-    PinsHiddenByDefault.Add(TEXT("NodeGuidStr"));
+    PinsHiddenByDefault.Add(TEXT("NodeGuid"));
+    PinsHiddenByDefault.Add(TEXT("Template"));
+    PinsHiddenByDefault.Add(TEXT("ReentrancyPolicy"));
 
     return PinsHiddenByDefault;
 }
@@ -0,0 +1,34 @@
+// Copyright (c) 2025 BlueprintTaskForge Maintainers
+// 
+// This file is part of the BlueprintTaskForge Plugin for Unreal Engine.
+// 
+// Licensed under the BlueprintTaskForge Open Plugin License v1.0 (BTFPL-1.0).
+// You may obtain a copy of the license at:
+// https://github.com/CommitAndChill/BlueprintTaskForge/blob/main/LICENSE.md
+// 
+// SPDX-License-Identifier: BTFPL-1.0
+
+
+#include "BtfTaskPreloadCompilerExtension.h"
+#include "BtfExtendConstructObject_K2Node.h"
+
+#include "KismetCompiler.h"
+
+// --------------------------------------------------------------------------------------------------------------------
+
+void UBtf_TaskPreloadCompilerExtension::Release()
+{
+    IsReleased = true;
+}
+
+void UBtf_TaskPreloadCompilerExtension::ProcessBlueprintCompiled(const FKismetCompilerContext& CompilationContext, const FBlueprintCompiledData& Data)
+{
+    Super::ProcessBlueprintCompiled(CompilationContext, Data);
+
+    if (IsReleased)
+    { return; }
+
+    UBtf_ExtendConstructObject_K2Node::UpdateTaskPreloadManifest(CompilationContext);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
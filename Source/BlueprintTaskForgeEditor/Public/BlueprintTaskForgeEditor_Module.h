@@ -13,10 +13,12 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 #include "Modules/ModuleInterface.h"
+#include "UObject/StrongObjectPtr.h"
 #include "BftMacros.h"
 
 class FBlueprintEditor;
 class FWorkflowAllowedTabSet;
+class UBtf_TaskPreloadCompilerExtension;
 class FString;
 class UObject;
 struct FAssetData;
@@ -45,6 +47,8 @@ private:
     FDelegateHandle OnFilesLoadedDelegateHandle;
     FDelegateHandle BlueprintEditorTabSpawnerHandle;
     FDelegateHandle BlueprintEditorLayoutExtensionHandle;
+
+    TStrongObjectPtr<UBtf_TaskPreloadCompilerExtension> TaskPreloadCompilerExtension;
 };
 
 // --------------------------------------------------------------------------------------------------------------------
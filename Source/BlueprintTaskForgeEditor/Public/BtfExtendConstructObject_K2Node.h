@@ -16,6 +16,7 @@
 #include "UObject/ObjectMacros.h"
 #include "BtfNameSelect.h"
 #include "BftMacros.h"
+#include "BtfTaskForge.h"
 
 #include "K2Node_DynamicCast.h"
 
@@ -90,6 +91,32 @@ public:
     UEdGraphPin* GetWorldContextPin() const;
     bool CanBePlacedInGraph() const;
     void GenerateCustomOutputPins();
+    /* Applies the connected @SpawnVarPins of @OwningNode to @SpawnedActorReturnPin with a single ApplySpawnParams call.
+     * Shared with the other nodes that expose spawn params, as are the helpers below. */
+    static bool ConnectPackedSpawnProperties(
+        UK2Node* OwningNode,
+        const TArray<UEdGraphPin*>& SpawnVarPins,
+        const UEdGraphSchema_K2* Schema,
+        class FKismetCompilerContext& CompilerContext,
+        UEdGraph* SourceGraph,
+        UEdGraphPin*& LastThenPin,
+        UEdGraphPin* SpawnedActorReturnPin);
+    /* Passes the names of @SpawnVarPins, in order, to the FName array pin @NamesPin. */
+    static bool ConnectSpawnParamNames(
+        UK2Node* OwningNode,
+        const TArray<UEdGraphPin*>& SpawnVarPins,
+        UEdGraphPin* NamesPin,
+        const UEdGraphSchema_K2* Schema,
+        class FKismetCompilerContext& CompilerContext,
+        UEdGraph* SourceGraph);
+    /* Creates the input pin of the spawn param @Property on @OwningNode, defaulted to its value on @ClassDefaultObject. */
+    static UEdGraphPin* CreateSpawnParamPin(UK2Node* OwningNode, const FProperty* Property, UObject* ClassDefaultObject);
+    /* Whether the unconnected @SpawnVarPin holds the class defaults value, it then does not need to be set. */
+    static bool IsSpawnParamPinAtClassDefault(const UEdGraphPin* SpawnVarPin, const UClass* ClassToSpawn, UK2Node* OwningNode);
+    /* Rebuilds the task preload manifest of the class being compiled from every task node of its Blueprint,
+     * including batch nodes. Called once per compile by UBtf_TaskPreloadCompilerExtension. */
+    static void UpdateTaskPreloadManifest(const class FKismetCompilerContext& CompilerContext);
+
     FName GetTemplateInstanceName() const { return FName(ProxyClass->GetName() + NodeGuid.ToString()); }
     UBtf_TaskForge* GetInstanceOrDefaultObject() const;
 
@@ -103,9 +130,22 @@ public:
     UPROPERTY()
     FName OutPutObjectPinName = FName(TEXT("Object"));
 
+    // Legacy string identity pin, only kept so that nodes saved with it reconstruct cleanly
     UPROPERTY()
     FName NodeGuidStrName = FName(TEXT("NodeGuidStr"));
 
+    UPROPERTY()
+    FName NodeGuidPinName = FName(TEXT("NodeGuid"));
+
+    UPROPERTY()
+    FName TemplatePinName = FName(TEXT("Template"));
+
+    UPROPERTY()
+    FName ReentrancyPolicyPinName = FName(TEXT("ReentrancyPolicy"));
+
+    UPROPERTY()
+    FName LoadingPinName = FName(TEXT("Loading"));
+
     // Core Properties
     UPROPERTY()
     UClass* ProxyFactoryClass;
@@ -150,6 +190,16 @@ public:
     UPROPERTY(EditAnywhere, Category = "ExposeOptions")
     bool OwnerContextPin = false;
 
+    /* What happens when the node is executed again on the same outer while the task it spawned before is still active. */
+    UPROPERTY(EditAnywhere, Category = "ExposeOptions")
+    EBtf_TaskReentrancyPolicy ReentrancyPolicy = EBtf_TaskReentrancyPolicy::Parallel;
+
+    /* Only references the task class by path from the compiled Blueprint, the class is streamed in the first time
+     * the node runs and the "Loading" pin fires while it is. The node output is typed as the closest native class,
+     * delegates declared in Blueprint are bound by name. */
+    UPROPERTY(EditAnywhere, Category = "Loading")
+    bool LoadClassAsynchronously = false;
+
     UPROPERTY(EditAnywhere, Category = "Instance")
     bool AllowInstance = false;
 
@@ -179,7 +229,7 @@ protected:
         static bool ValidDataPin(const UEdGraphPin* Pin, EEdGraphPinDirection Direction);
         static bool CreateDelegateForNewFunction(UEdGraphPin* DelegateInputPin, FName FunctionName, UK2Node* CurrentNode, UEdGraph* SourceGraph, FKismetCompilerContext& CompilerContext);
         static bool CopyEventSignature(class UK2Node_CustomEvent* CENode, UFunction* Function, const UEdGraphSchema_K2* Schema);
-        static bool HandleDelegateImplementation(FMulticastDelegateProperty* CurrentProperty, const TArray<FOutputPinAndLocalVariable>& VariableOutputs, UEdGraphPin* ProxyObjectPin, UEdGraphPin*& InOutLastThenPin, UK2Node* CurrentNode, UEdGraph* SourceGraph, FKismetCompilerContext& CompilerContext);
+        static bool HandleDelegateImplementation(FMulticastDelegateProperty* CurrentProperty, const TArray<FOutputPinAndLocalVariable>& VariableOutputs, UEdGraphPin* ProxyObjectPin, UEdGraphPin*& InOutLastThenPin, UK2Node* CurrentNode, UEdGraph* SourceGraph, FKismetCompilerContext& CompilerContext, bool BindByName = false);
         static bool HandleCustomPinsImplementation(FMulticastDelegateProperty* CurrentProperty, UEdGraphPin* ProxyObjectPin, UEdGraphPin*& InOutLastThenPin, UK2Node* CurrentNode, UEdGraph* SourceGraph, TArray<FCustomOutputPin> OutputNames, FKismetCompilerContext& CompilerContext);
     };
 
@@ -231,6 +281,11 @@ protected:
     UEdGraphPin* CastProxyObjectIfNeeded(FKismetCompilerContext& CompilerContext,
                                         UEdGraph* SourceGraph,
                                         UEdGraphPin* ProxyObjectPin);
+    bool ConnectAsyncClassLoad(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph, UK2Node_CallFunction* ProxyNode);
+
+    /* Class the node output is typed as, the task class itself unless it is loaded asynchronously. */
+    UClass* Get_OutputObjectClass(UClass* TargetClass) const;
+    bool IsReferencedByPath(const UClass* OwnerClass) const;
     TArray<FNodeHelper::FOutputPinAndLocalVariable> CreateVariableOutputs(FKismetCompilerContext& CompilerContext);
     bool ProcessInputDelegates(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph,
                               UEdGraphPin* ProxyObjectPin, UEdGraphPin*& LastThenPin);
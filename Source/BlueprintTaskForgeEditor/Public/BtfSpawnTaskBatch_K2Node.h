@@ -0,0 +1,66 @@
+// Copyright (c) 2025 BlueprintTaskForge Maintainers
+//
+// This file is part of the BlueprintTaskForge Plugin for Unreal Engine.
+//
+// Licensed under the BlueprintTaskForge Open Plugin License v1.0 (BTFPL-1.0).
+// You may obtain a copy of the license at:
+// https://github.com/CommitAndChill/BlueprintTaskForge/blob/main/LICENSE.md
+//
+// SPDX-License-Identifier: BTFPL-1.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "K2Node.h"
+#include "BtfTaskForge.h"
+
+#include "BtfSpawnTaskBatch_K2Node.generated.h"
+
+// --------------------------------------------------------------------------------------------------------------------
+
+class FBlueprintActionDatabaseRegistrar;
+class UEdGraph;
+
+/* Spawns a batch of tasks of the same class through UBtf_TaskForge::SpawnTaskBatch.
+ * The spawn params of the class are exposed as pins and shared by every task of the batch,
+ * literal values are baked into a params template of the generated class when compiling. */
+UCLASS()
+class BLUEPRINTTASKFORGEEDITOR_API UBtf_SpawnTaskBatch_K2Node : public UK2Node
+{
+    GENERATED_BODY()
+
+public:
+    UBtf_SpawnTaskBatch_K2Node(const FObjectInitializer& ObjectInitializer);
+
+    // UEdGraphNode interface
+    virtual void AllocateDefaultPins() override;
+    virtual FText GetTooltipText() const override;
+    virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+    virtual FSlateIcon GetIconAndTint(FLinearColor& OutColor) const override;
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+    virtual bool ShouldShowNodeProperties() const override { return true; }
+    // End of UEdGraphNode interface
+
+    // UK2Node interface
+    virtual FText GetMenuCategory() const override;
+    virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
+    virtual void ExpandNode(class FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+    virtual void EarlyValidation(class FCompilerResultsLog& MessageLog) const override;
+    virtual bool IsNodePure() const override { return false; }
+    // End of UK2Node interface
+
+    // Properties
+    UPROPERTY(EditAnywhere, Category = "Task")
+    TSubclassOf<UBtf_TaskForge> TaskClass;
+
+private:
+    void CreateSpawnParamPins();
+    TArray<UEdGraphPin*> GetSpawnParamPins() const;
+
+    static const FName PN_Outers;
+    static const FName PN_CountPerOuter;
+    static const FName PN_ActivateTasks;
+    static const FName PN_Tasks;
+};
+
+// --------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,39 @@
+// Copyright (c) 2025 BlueprintTaskForge Maintainers
+// 
+// This file is part of the BlueprintTaskForge Plugin for Unreal Engine.
+// 
+// Licensed under the BlueprintTaskForge Open Plugin License v1.0 (BTFPL-1.0).
+// You may obtain a copy of the license at:
+// https://github.com/CommitAndChill/BlueprintTaskForge/blob/main/LICENSE.md
+// 
+// SPDX-License-Identifier: BTFPL-1.0
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintCompilerExtension.h"
+
+#include "BtfTaskPreloadCompilerExtension.generated.h"
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/* Rebuilds the task preload manifest of every Blueprint once its compilation is done, from all of its task nodes at once. */
+UCLASS()
+class BLUEPRINTTASKFORGEEDITOR_API UBtf_TaskPreloadCompilerExtension : public UBlueprintCompilerExtension
+{
+    GENERATED_BODY()
+
+public:
+    /* The compilation manager cannot unregister extensions, this stops a registered one from doing anything
+     * once the module that registered it shuts down. */
+    void Release();
+
+protected:
+    virtual void ProcessBlueprintCompiled(const FKismetCompilerContext& CompilationContext, const FBlueprintCompiledData& Data) override;
+
+private:
+    bool IsReleased = false;
+};
+
+// --------------------------------------------------------------------------------------------------------------------